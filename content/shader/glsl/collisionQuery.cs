@@ -0,0 +1,45 @@
+#version 430 core
+
+// Same scan than PhysicSystem::processContinuousCollision: one invocation per step along the movement, the first
+// step where the foot basement covers enough edge pixels is kept
+layout (local_size_x = 64) in;
+
+// texture samplers
+layout (binding = 0) uniform sampler2D uEdgeTexture;
+
+layout (std430, binding = 0) buffer HitBuffer
+{
+    int hitStep; // Reset to the max int by the CPU
+};
+
+uniform vec2  uStart; // Column and row of the first step, from the top left corner
+uniform vec2  uStep;
+uniform int   uStepCount;
+uniform int   uFootBasementWidth;
+uniform int   uFootBasementHeight;
+uniform float uStopRatio;
+
+void main()
+{
+    int step = int(gl_GlobalInvocationID.x);
+    if (step >= uStepCount)
+        return;
+
+    vec2 position = uStart + uStep * float(step);
+    int  column   = int(position.x);
+    int  row      = int(position.y);
+    int  height   = textureSize(uEdgeTexture, 0).y;
+
+    int count = 0;
+    for (int y = 0; y < uFootBasementHeight; y++)
+    {
+        for (int x = 0; x < uFootBasementWidth; x++)
+        {
+            // flip Y
+            count += int(texelFetch(uEdgeTexture, ivec2(column + x, height - 1 - row - y), 0).r > 0.5);
+        }
+    }
+
+    if (float(count) / float(uFootBasementWidth * uFootBasementHeight) > uStopRatio)
+        atomicMin(hitStep, step);
+}
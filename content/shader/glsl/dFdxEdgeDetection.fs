@@ -1,4 +1,4 @@
-#version 460 core
+#version 450 core
 
 // based on https://www.shadertoy.com/view/Xly3DV
 layout (location = 0) out float FragColor;
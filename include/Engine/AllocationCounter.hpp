@@ -0,0 +1,6 @@
+#pragma once
+
+#include <cstddef>
+
+// Number of heap allocations done with the global operator new since the start, all threads included
+size_t getAllocationCount() noexcept;
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "Engine/Singleton.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Pack of pre-decoded images generated at build time by the AssetPacker tool (pack_assets target), rebuilt when a
+// sprite changes. The file is memory mapped and textures are uploaded straight from it, without decoding or copy.
+// Loose images stay the reference: an entry is ignored if the size of the image file next to it changed. The write
+// time can't be compared, the copy of the content directory in the build directory doesn't keep it.
+namespace AssetPackFormat
+{
+constexpr uint32_t magic   = 0x50444650; // "PFDP"
+constexpr uint32_t version = 2;
+
+// Pixels and mask offsets are aligned on this value
+constexpr uint64_t dataAlignment = 16;
+
+enum EEntryFlag : uint32_t
+{
+    VerticalFlip = 1 << 0
+};
+
+struct Header
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t reserved;
+};
+
+// Entries are sorted by path (strcmp order)
+struct Entry
+{
+    char     path[112]; // Relative to the resource directory, '/' separator
+    uint32_t width;
+    uint32_t height;
+    uint32_t channels;
+    uint32_t flags;
+    uint64_t sourceSize;
+    uint64_t pixelsOffset;
+    uint64_t pixelsSize;
+    uint64_t opacityMaskOffset; // One bit per pixel, set if alpha > 0. Same layout than pixels
+    uint64_t opacityMaskSize;
+};
+} // namespace AssetPackFormat
+
+class AssetPack : public Singleton<AssetPack>
+{
+public:
+    struct Image
+    {
+        const unsigned char* pixels      = nullptr;
+        const unsigned char* opacityMask = nullptr;
+        int                  width       = 0;
+        int                  height      = 0;
+        int                  channels    = 0;
+    };
+
+protected:
+    const unsigned char*           m_data          = nullptr;
+    size_t                         m_size          = 0;
+    const AssetPackFormat::Header* m_header        = nullptr;
+    const AssetPackFormat::Entry*  m_entries       = nullptr;
+    void*                          m_fileHandle    = nullptr; // Only used on Windows
+    void*                          m_mappingHandle = nullptr;
+
+    // Images found or not in the pack. Mutable because workers look for images concurrently
+    mutable std::atomic<int> m_hitCount  = 0;
+    mutable std::atomic<int> m_missCount = 0;
+
+protected:
+    static bool isPathLess(const AssetPackFormat::Entry& lhs, const AssetPackFormat::Entry& rhs);
+
+    bool isEntryUpToDate(const AssetPackFormat::Entry& entry, const std::string& sourcePath) const;
+
+public:
+    ~AssetPack();
+
+    // Return false if the pack doesn't exist or is invalid. The game then only use loose files.
+    bool open(const char* path);
+
+    void close();
+
+    bool isOpen() const noexcept
+    {
+        return m_header != nullptr;
+    }
+
+    int getHitCount() const noexcept
+    {
+        return m_hitCount.load(std::memory_order_relaxed);
+    }
+
+    int getMissCount() const noexcept
+    {
+        return m_missCount.load(std::memory_order_relaxed);
+    }
+
+    // Path with the resource directory prefix, like the one given to Texture. Binary search in the sorted entries.
+    bool find(const std::string& path, bool verticalFlip, Image& image) const;
+};
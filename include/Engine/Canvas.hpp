@@ -1,5 +1,8 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <list>
 #include <memory>
 
@@ -8,13 +11,111 @@
 
 class Canvas : public Rect
 {
+public:
+    // Region to redraw, expressed in canvas local pixel coordinates (upper left origin)
+    struct DamageRegion
+    {
+        Vec2i min = {0, 0};
+        Vec2i max = {0, 0};
+
+        bool isEmpty() const noexcept
+        {
+            return max.x <= min.x || max.y <= min.y;
+        }
+
+        void merge(const DamageRegion& other) noexcept
+        {
+            if (other.isEmpty())
+                return;
+
+            if (isEmpty())
+            {
+                *this = other;
+                return;
+            }
+
+            min.x = std::min(min.x, other.min.x);
+            min.y = std::min(min.y, other.min.y);
+            max.x = std::max(max.x, other.max.x);
+            max.y = std::max(max.y, other.max.y);
+        }
+    };
+
 protected:
+    // Back buffer content is only valid if it was drawn during the last frames. Swap chain rarely keep more than 3
+    // buffers so the damage of the 3 last frames is enough to refresh any of them.
+    static constexpr size_t s_damageHistorySize = 3;
+
     std::list<Rect*> m_elements;
 
+    std::array<DamageRegion, s_damageHistorySize> m_damageHistory;
+    size_t                                        m_damageHistoryIndex = 0;
+    DamageRegion                                  m_pendingDamage;
+    Vec2                                          m_lastDrawPosition = {0, 0};
+    Vec2                                          m_lastDrawSize     = {0, 0};
+
+    DamageRegion toLocalRegion(Vec2 cornerMin, Vec2 cornerMax) const noexcept
+    {
+        // Sprite position are not pixel aligned, keep one pixel of margin to include filtering
+        DamageRegion region;
+        region.min = {static_cast<int>(std::floor(cornerMin.x - m_position.x)) - 1,
+                      static_cast<int>(std::floor(cornerMin.y - m_position.y)) - 1};
+        region.max = {static_cast<int>(std::ceil(cornerMax.x - m_position.x)) + 1,
+                      static_cast<int>(std::ceil(cornerMax.y - m_position.y)) + 1};
+        return region;
+    }
+
 public:
     void addElement(Rect& element)
     {
         m_elements.emplace_back(&element);
         element.setOnChange([&](const Rect& other) { encapsulate(other); });
     }
-};
\ No newline at end of file
+
+    // Area not linked to an element (removed element, ImGui popup...) to refresh during the next frame
+    void addDamage(Vec2 cornerMin, Vec2 cornerMax) noexcept
+    {
+        m_pendingDamage.merge(toLocalRegion(cornerMin, cornerMax));
+    }
+
+    void addDamage(const Rect& element) noexcept
+    {
+        addDamage(element.getCornerMin(), element.getCornerMax());
+    }
+
+    // Return the union of the previous and current area of all elements. Consume the pending damage.
+    DamageRegion computeFrameDamage() noexcept
+    {
+        const DamageRegion fullRegion{{0, 0}, {static_cast<int>(m_size.x), static_cast<int>(m_size.y)}};
+
+        DamageRegion currentDamage = m_pendingDamage;
+        m_pendingDamage            = {};
+        for (const Rect* element : m_elements)
+        {
+            currentDamage.merge(toLocalRegion(element->getCornerMin(), element->getCornerMax()));
+        }
+
+        DamageRegion frameDamage = currentDamage;
+        for (const DamageRegion& previousDamage : m_damageHistory)
+        {
+            frameDamage.merge(previousDamage);
+        }
+
+        // Canvas moved or resized: previous content is no longer aligned
+        if (!(m_lastDrawPosition == m_position) || !(m_lastDrawSize == m_size))
+        {
+            frameDamage        = fullRegion;
+            m_lastDrawPosition = m_position;
+            m_lastDrawSize     = m_size;
+        }
+
+        m_damageHistory[m_damageHistoryIndex] = currentDamage;
+        m_damageHistoryIndex                  = (m_damageHistoryIndex + 1) % s_damageHistorySize;
+
+        frameDamage.min.x = std::clamp(frameDamage.min.x, 0, fullRegion.max.x);
+        frameDamage.min.y = std::clamp(frameDamage.min.y, 0, fullRegion.max.y);
+        frameDamage.max.x = std::clamp(frameDamage.max.x, 0, fullRegion.max.x);
+        frameDamage.max.y = std::clamp(frameDamage.max.y, 0, fullRegion.max.y);
+        return frameDamage;
+    }
+};
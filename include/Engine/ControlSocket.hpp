@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Local (Unix domain) socket where each request is a line answered by a line. Sockets are non blocking: poll accepts
+// the clients, reads what is available and sends what it can, the rest waits for the next poll.
+class ControlSocket
+{
+public:
+    // Request without its end of line. Response is empty and don't need the end of line.
+    using RequestHandler = std::function<void(const std::string& request, std::string& response)>;
+
+    static constexpr size_t s_maxClientCount = 8;
+    static constexpr size_t s_maxLineSize    = 64 * 1024; // Client is disconnected if its line is longer
+
+protected:
+#ifdef _WIN32
+    using SocketHandle = uintptr_t;
+#else
+    using SocketHandle = int;
+#endif
+
+    struct Client
+    {
+        SocketHandle socket;
+        std::string  input;  // Received, not processed
+        std::string  output; // Not sent yet
+        bool         isClosed = false;
+    };
+
+    SocketHandle        m_listenSocket;
+    std::string         m_path;
+    std::vector<Client> m_clients;
+    std::string         m_response; // Reused by each request
+
+protected:
+    void receive(Client& client, const RequestHandler& handler);
+
+    void send(Client& client);
+
+public:
+    ControlSocket();
+
+    ~ControlSocket();
+
+    ControlSocket(const ControlSocket&)            = delete;
+    ControlSocket& operator=(const ControlSocket&) = delete;
+
+    // Replace the socket file if it already exists
+    bool open(const std::string& path);
+
+    void close();
+
+    bool isOpen() const noexcept;
+
+    void poll(const RequestHandler& handler);
+
+    // Quoted and escaped
+    static void appendJSONString(std::string& out, const char* text);
+};
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "Engine/RingBuffer.hpp"
+#include "Engine/Vector2.hpp"
+
+// Timestamped cursor positions of the last moments, used to estimate the cursor velocity when a pet is released.
+// Samples are pushed by the cursor callback and read by the main loop.
+class CursorTracker
+{
+public:
+    struct Sample
+    {
+        double time = 0.; // In seconds
+        Vec2   position{0.f, 0.f};
+    };
+
+    // More than one second of a 1000 Hz mouse
+    static constexpr size_t s_capacity = 1024;
+
+protected:
+    SPSCRingBuffer<Sample, s_capacity> m_samples;
+
+public:
+    // Producer. The sample is dropped if the consumer did not remove the old samples
+    bool addSample(double time, Vec2 position) noexcept
+    {
+        return m_samples.tryPush({time, position});
+    }
+
+    // Consumer
+    void removeSamplesBefore(double time) noexcept
+    {
+        const size_t size  = m_samples.size();
+        size_t       count = 0;
+        while (count < size && m_samples[count].time < time)
+            ++count;
+        m_samples.pop(count);
+    }
+
+    // Consumer
+    void clear() noexcept
+    {
+        m_samples.clear();
+    }
+
+    // Consumer
+    size_t getSampleCount() const noexcept
+    {
+        return m_samples.size();
+    }
+
+    // Consumer. Least squares slope of the positions over [time - window, time] in pixel per second. The current
+    // position is added at time so that a cursor stopped before the end of the window slows down the estimation.
+    Vec2 computeVelocity(double time, double window, Vec2 currentPosition) const noexcept
+    {
+        const size_t size = m_samples.size();
+
+        // Centered on the current sample to keep the precision of the time sums
+        double count = 1., sumT = 0., sumTT = 0.;
+        double sumX = currentPosition.x, sumY = currentPosition.y, sumTX = 0., sumTY = 0.;
+        for (size_t i = 0; i < size; ++i)
+        {
+            const Sample& sample = m_samples[i];
+            const double  t      = sample.time - time;
+            if (t < -window || t > 0.)
+                continue;
+
+            count += 1.;
+            sumT += t;
+            sumTT += t * t;
+            sumX += sample.position.x;
+            sumY += sample.position.y;
+            sumTX += t * sample.position.x;
+            sumTY += t * sample.position.y;
+        }
+
+        const double denominator = count * sumTT - sumT * sumT;
+        if (count < 2. || denominator <= 1e-12)
+            return {0.f, 0.f};
+
+        return {static_cast<float>((count * sumTX - sumT * sumX) / denominator),
+                static_cast<float>((count * sumTY - sumT * sumY) / denominator)};
+    }
+};
@@ -0,0 +1,180 @@
+#pragma once
+
+#include "Engine/AllocationCounter.hpp"
+#include "Engine/Singleton.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iterator>
+
+enum class EFrameStage : uint8_t
+{
+    Input = 0,
+    Physic,
+    Capture,
+    EdgeDetection,
+    Animation,
+    UI,
+    Draw,
+    Present,
+
+    COUNT
+};
+
+// Main thread work between two rendered frames, split by stage. Work of the updates without rendering (ex: physic
+// step) is counted in the next rendered frame. Stages can be nested, the time of a nested stage is excluded from its
+// parent.
+class FrameStats : public Singleton<FrameStats>
+{
+public:
+    static constexpr size_t s_historySize = 240;
+
+    // Upper bounds of the frame time histogram
+    static constexpr double s_frameTimeBuckets_s[] = {0.001, 0.002, 0.004, 0.008, 0.016, 0.033, 0.066};
+    static constexpr size_t s_frameTimeBucketCount = std::size(s_frameTimeBuckets_s);
+
+    static constexpr const char* s_stageNames[] = {"Input",     "Physic", "Capture", "Edge detection",
+                                                   "Animation", "UI",     "Draw",    "Present"};
+
+    struct Frame
+    {
+        float    stages_ms[static_cast<size_t>(EFrameStage::COUNT)] = {};
+        float    total_ms                                           = 0.f;
+        uint32_t allocationCount                                    = 0;
+        uint32_t drawCallCount                                      = 0;
+        uint64_t captureBytes                                       = 0;
+    };
+
+protected:
+    using Clock = std::chrono::steady_clock;
+
+    Frame  m_history[s_historySize];
+    size_t m_frameCount = 0; // Rendered since the start
+
+    // Since the start, each bucket counts the frames not longer than its bound
+    uint64_t m_frameTimeBucketCounts[s_frameTimeBucketCount] = {};
+    double   m_frameTimeSum_s                                = 0.;
+
+    Frame             m_currentFrame;
+    EFrameStage       m_currentStage    = EFrameStage::COUNT; // COUNT if outside of any stage
+    Clock::time_point m_stageStart;
+    size_t            m_allocationStart = getAllocationCount();
+
+protected:
+    void accumulateCurrentStage(Clock::time_point now) noexcept
+    {
+        if (m_currentStage != EFrameStage::COUNT)
+            m_currentFrame.stages_ms[static_cast<size_t>(m_currentStage)] +=
+                std::chrono::duration<float, std::milli>(now - m_stageStart).count();
+        m_stageStart = now;
+    }
+
+public:
+    // Return the stage to restore on exit
+    EFrameStage enterStage(EFrameStage stage) noexcept
+    {
+        accumulateCurrentStage(Clock::now());
+        const EFrameStage previousStage = m_currentStage;
+        m_currentStage                  = stage;
+        return previousStage;
+    }
+
+    void exitStage(EFrameStage previousStage) noexcept
+    {
+        accumulateCurrentStage(Clock::now());
+        m_currentStage = previousStage;
+    }
+
+    void addDrawCalls(uint32_t count) noexcept
+    {
+        m_currentFrame.drawCallCount += count;
+    }
+
+    void addCaptureBytes(uint64_t bytes) noexcept
+    {
+        m_currentFrame.captureBytes += bytes;
+    }
+
+    // Called once the frame is presented
+    void endFrame() noexcept
+    {
+        m_currentFrame.total_ms = 0.f;
+        for (const float stage_ms : m_currentFrame.stages_ms)
+            m_currentFrame.total_ms += stage_ms;
+
+        const size_t allocationCount = getAllocationCount();
+        m_currentFrame.allocationCount = static_cast<uint32_t>(allocationCount - m_allocationStart);
+        m_allocationStart              = allocationCount;
+
+        const double total_s = m_currentFrame.total_ms / 1000.;
+        m_frameTimeSum_s += total_s;
+        for (size_t i = 0; i < s_frameTimeBucketCount; ++i)
+            m_frameTimeBucketCounts[i] += total_s <= s_frameTimeBuckets_s[i];
+
+        m_history[m_frameCount % s_historySize] = m_currentFrame;
+        ++m_frameCount;
+        m_currentFrame = Frame{};
+    }
+
+    size_t getFrameCount() const noexcept
+    {
+        return m_frameCount;
+    }
+
+    const uint64_t* getFrameTimeBucketCounts() const noexcept
+    {
+        return m_frameTimeBucketCounts;
+    }
+
+    double getFrameTimeSum_s() const noexcept
+    {
+        return m_frameTimeSum_s;
+    }
+
+    size_t getHistoryCount() const noexcept
+    {
+        return m_frameCount < s_historySize ? m_frameCount : s_historySize;
+    }
+
+    // Over the frames of the history
+    float computeTotalPercentile_ms(float percentile) const noexcept
+    {
+        const size_t count = getHistoryCount();
+        if (count == 0)
+            return 0.f;
+
+        float totals_ms[s_historySize];
+        for (size_t i = 0; i < count; ++i)
+            totals_ms[i] = getFrame(i).total_ms;
+
+        const size_t index = std::min(static_cast<size_t>(percentile * count), count - 1);
+        std::nth_element(totals_ms, totals_ms + index, totals_ms + count);
+        return totals_ms[index];
+    }
+
+    // 0 is the oldest frame still in the history
+    const Frame& getFrame(size_t index) const noexcept
+    {
+        return m_history[(m_frameCount - getHistoryCount() + index) % s_historySize];
+    }
+};
+
+class FrameStageTimer
+{
+protected:
+    EFrameStage m_previousStage;
+
+public:
+    explicit FrameStageTimer(EFrameStage stage) noexcept : m_previousStage{FrameStats::instance().enterStage(stage)}
+    {
+    }
+
+    FrameStageTimer(const FrameStageTimer&)            = delete;
+    FrameStageTimer& operator=(const FrameStageTimer&) = delete;
+
+    ~FrameStageTimer()
+    {
+        FrameStats::instance().exitStage(m_previousStage);
+    }
+};
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "Engine/Graphics/GPUProfilerOGL.hpp"
+#include "Engine/Graphics/ShaderOGL.hpp"
+#include "Engine/Graphics/TextureOGL.hpp"
+#include "Engine/Vector2.hpp"
+
+#include <glad/glad.h>
+
+#include <climits>
+
+// Scan of the edge mask for the continuous collision on the GPU (see PhysicSystem::processContinuousCollision).
+// All the steps of the movement are evaluated in parallel and only the first colliding step is read back, through a
+// persistently mapped buffer instead of the whole mask.
+class CollisionQuery
+{
+protected:
+    static constexpr int        s_localSize      = 64; // local_size_x of the shader
+    static constexpr GLuint64   s_waitTimeout_ns = 1000000000;
+    static constexpr GLbitfield s_mappingFlags =
+        GL_MAP_READ_BIT | GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+    Shader        m_shader;
+    UniformVec2   m_uStart;
+    UniformVec2   m_uStep;
+    UniformInt    m_uStepCount;
+    UniformInt    m_uFootBasementWidth;
+    UniformInt    m_uFootBasementHeight;
+    UniformFloat  m_uStopRatio;
+    unsigned int  m_buffer;
+    volatile int* m_hitStep; // Written by the GPU
+
+public:
+    // Compute shaders (4.3), persistent buffer storage (4.4) and the direct state access buffer calls (4.5)
+    static bool isSupported()
+    {
+        return GLAD_GL_VERSION_4_5;
+    }
+
+    CollisionQuery(Window& window) : m_shader(window, SHADER_RESOURCE_PATH "/collisionQuery" SHADER_COMPUTE_EXT)
+    {
+        m_uStart              = m_shader.getUniform<UniformVec2>("uStart");
+        m_uStep               = m_shader.getUniform<UniformVec2>("uStep");
+        m_uStepCount          = m_shader.getUniform<UniformInt>("uStepCount");
+        m_uFootBasementWidth  = m_shader.getUniform<UniformInt>("uFootBasementWidth");
+        m_uFootBasementHeight = m_shader.getUniform<UniformInt>("uFootBasementHeight");
+        m_uStopRatio          = m_shader.getUniform<UniformFloat>("uStopRatio");
+
+        glCreateBuffers(1, &m_buffer);
+        glNamedBufferStorage(m_buffer, sizeof(int), nullptr, s_mappingFlags);
+        m_hitStep = static_cast<int*>(glMapNamedBufferRange(m_buffer, 0, sizeof(int), s_mappingFlags));
+    }
+
+    ~CollisionQuery()
+    {
+        glUnmapNamedBuffer(m_buffer);
+        glDeleteBuffers(1, &m_buffer);
+    }
+
+    CollisionQuery(const CollisionQuery&)            = delete;
+    CollisionQuery& operator=(const CollisionQuery&) = delete;
+
+    // Start and step are in pixels from the top left corner of the texture. Return the index of the first step where
+    // the ratio of edge pixels under the foot basement is above stopRatio, -1 if there is none.
+    int query(const Texture& edgeTexture, Vec2 start, Vec2 step, int stepCount, int footBasementWidth,
+              int footBasementHeight, float stopRatio)
+    {
+        *m_hitStep = INT_MAX;
+
+        m_shader.use();
+        m_shader.set(m_uStart, start.x, start.y);
+        m_shader.set(m_uStep, step.x, step.y);
+        m_shader.set(m_uStepCount, stepCount);
+        m_shader.set(m_uFootBasementWidth, footBasementWidth);
+        m_shader.set(m_uFootBasementHeight, footBasementHeight);
+        m_shader.set(m_uStopRatio, stopRatio);
+        edgeTexture.use();
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, m_buffer);
+        glDispatchCompute((stepCount + s_localSize - 1) / s_localSize, 1, 1);
+
+        // Make the atomic writes visible through the mapping, then wait for them
+        glMemoryBarrier(GL_CLIENT_MAPPED_BUFFER_BARRIER_BIT);
+        GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        while (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, s_waitTimeout_ns) == GL_TIMEOUT_EXPIRED)
+        {
+        }
+        glDeleteSync(fence);
+        GPUProfiler::instance().addReadback(sizeof(int));
+
+        const int hitStep = *m_hitStep;
+        return hitStep == INT_MAX ? -1 : hitStep;
+    }
+};
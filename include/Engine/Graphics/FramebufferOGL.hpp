@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Engine/Graphics/GLStateOGL.hpp"
 #include "Engine/Graphics/TextureOGL.hpp"
 #include "Engine/Log.hpp"
 
@@ -19,11 +20,12 @@ public:
     ~Framebuffer()
     {
         glDeleteFramebuffers(1, &ID);
+        GLState::instance().onFramebufferDeleted(ID);
     }
 
     void bind()
     {
-        glBindFramebuffer(GL_FRAMEBUFFER, ID);
+        GLState::instance().bindFramebuffer(ID);
     }
 
     void attachTexture(const Texture& texture)
@@ -39,6 +41,6 @@ public:
 
     static void bindScreen()
     {
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        GLState::instance().bindFramebuffer(0);
     }
 };
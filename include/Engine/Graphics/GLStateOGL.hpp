@@ -0,0 +1,214 @@
+#pragma once
+
+#include "Engine/ClassUtility.hpp"
+#include "Engine/Singleton.hpp"
+
+#include <glad/glad.h>
+
+#include <cstdint>
+
+// Last GL state set through this class, so that the calls that would not change it are skipped. Code that changes
+// the state directly (ex: the ImGui backend) need to call invalidate after.
+class GLState : public Singleton<GLState>
+{
+public:
+    enum class ECapability : uint8_t
+    {
+        Blend,
+        ScissorTest,
+        DepthTest,
+        CullFace,
+        Count
+    };
+
+protected:
+    static constexpr unsigned int s_unknown          = ~0u;
+    static constexpr int          s_textureUnitCount = 4; // Only the first ones are used
+    static constexpr GLenum       s_capabilities[]   = {GL_BLEND, GL_SCISSOR_TEST, GL_DEPTH_TEST, GL_CULL_FACE};
+
+    unsigned int m_program                    = s_unknown;
+    unsigned int m_vertexArray                = s_unknown;
+    unsigned int m_framebuffer                = s_unknown;
+    unsigned int m_activeTexture              = s_unknown; // Index of the unit
+    unsigned int m_textures[s_textureUnitCount]; // 2D texture of each unit
+    int          m_viewport[4];
+    int8_t       m_capabilities[static_cast<size_t>(ECapability::Count)]; // -1 if unknown
+    int8_t       m_depthMask = -1;
+    GLenum       m_blendSource;
+    GLenum       m_blendDestination;
+    float        m_clearColor[4];
+
+    // Since the start
+    uint64_t m_callCount       = 0;
+    uint64_t m_elidedCallCount = 0; // Not forwarded to GL because the state was already set
+
+protected:
+    // Count the call and return true if it need to be forwarded
+    bool shouldSet(bool isAlreadySet) noexcept
+    {
+        ++m_callCount;
+        m_elidedCallCount += isAlreadySet;
+        return !isAlreadySet;
+    }
+
+public:
+    GETTER_BY_VALUE(CallCount, m_callCount)
+    GETTER_BY_VALUE(ElidedCallCount, m_elidedCallCount)
+
+    GLState()
+    {
+        invalidate();
+    }
+
+    void invalidate() noexcept
+    {
+        m_program       = s_unknown;
+        m_vertexArray   = s_unknown;
+        m_framebuffer   = s_unknown;
+        m_activeTexture = s_unknown;
+        for (unsigned int& texture : m_textures)
+            texture = s_unknown;
+        for (int& value : m_viewport)
+            value = -1;
+        for (int8_t& capability : m_capabilities)
+            capability = -1;
+        m_depthMask        = -1;
+        m_blendSource      = GL_NONE;
+        m_blendDestination = GL_NONE;
+        for (float& value : m_clearColor)
+            value = -1.f;
+    }
+
+    void useProgram(unsigned int program)
+    {
+        if (shouldSet(m_program == program))
+        {
+            glUseProgram(program);
+            m_program = program;
+        }
+    }
+
+    void bindVertexArray(unsigned int vertexArray)
+    {
+        if (shouldSet(m_vertexArray == vertexArray))
+        {
+            glBindVertexArray(vertexArray);
+            m_vertexArray = vertexArray;
+        }
+    }
+
+    // Read and draw framebuffer
+    void bindFramebuffer(unsigned int framebuffer)
+    {
+        if (shouldSet(m_framebuffer == framebuffer))
+        {
+            glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+            m_framebuffer = framebuffer;
+        }
+    }
+
+    // Unit index, not GL_TEXTURE0 + index
+    void activeTexture(unsigned int unit)
+    {
+        if (shouldSet(m_activeTexture == unit))
+        {
+            glActiveTexture(GL_TEXTURE0 + unit);
+            m_activeTexture = unit;
+        }
+    }
+
+    // On the active unit
+    void bindTexture(unsigned int texture)
+    {
+        if (m_activeTexture >= s_textureUnitCount)
+        {
+            ++m_callCount;
+            glBindTexture(GL_TEXTURE_2D, texture);
+            return;
+        }
+
+        if (shouldSet(m_textures[m_activeTexture] == texture))
+        {
+            glBindTexture(GL_TEXTURE_2D, texture);
+            m_textures[m_activeTexture] = texture;
+        }
+    }
+
+    void viewport(int x, int y, int width, int height)
+    {
+        if (shouldSet(m_viewport[0] == x && m_viewport[1] == y && m_viewport[2] == width && m_viewport[3] == height))
+        {
+            glViewport(x, y, width, height);
+            m_viewport[0] = x;
+            m_viewport[1] = y;
+            m_viewport[2] = width;
+            m_viewport[3] = height;
+        }
+    }
+
+    void setCapability(ECapability capability, bool isEnabled)
+    {
+        int8_t& state = m_capabilities[static_cast<size_t>(capability)];
+        if (shouldSet(state == static_cast<int8_t>(isEnabled)))
+        {
+            if (isEnabled)
+                glEnable(s_capabilities[static_cast<size_t>(capability)]);
+            else
+                glDisable(s_capabilities[static_cast<size_t>(capability)]);
+            state = static_cast<int8_t>(isEnabled);
+        }
+    }
+
+    void blendFunc(GLenum source, GLenum destination)
+    {
+        if (shouldSet(m_blendSource == source && m_blendDestination == destination))
+        {
+            glBlendFunc(source, destination);
+            m_blendSource      = source;
+            m_blendDestination = destination;
+        }
+    }
+
+    void depthMask(bool isWritten)
+    {
+        if (shouldSet(m_depthMask == static_cast<int8_t>(isWritten)))
+        {
+            glDepthMask(isWritten ? GL_TRUE : GL_FALSE);
+            m_depthMask = static_cast<int8_t>(isWritten);
+        }
+    }
+
+    void clearColor(float r, float g, float b, float a)
+    {
+        if (shouldSet(m_clearColor[0] == r && m_clearColor[1] == g && m_clearColor[2] == b && m_clearColor[3] == a))
+        {
+            glClearColor(r, g, b, a);
+            m_clearColor[0] = r;
+            m_clearColor[1] = g;
+            m_clearColor[2] = b;
+            m_clearColor[3] = a;
+        }
+    }
+
+    // Deleted objects are unbound by GL, their name can be reused by the next creation
+    void onTextureDeleted(unsigned int texture) noexcept
+    {
+        for (unsigned int& boundTexture : m_textures)
+        {
+            if (boundTexture == texture)
+                boundTexture = 0;
+        }
+    }
+
+    void onVertexArrayDeleted(unsigned int vertexArray) noexcept
+    {
+        if (m_vertexArray == vertexArray)
+            m_vertexArray = 0;
+    }
+
+    void onFramebufferDeleted(unsigned int framebuffer) noexcept
+    {
+        if (m_framebuffer == framebuffer)
+            m_framebuffer = 0;
+    }
+};
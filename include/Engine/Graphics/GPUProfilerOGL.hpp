@@ -0,0 +1,154 @@
+#pragma once
+
+#include "Engine/FrameStats.hpp"
+#include "Engine/Singleton.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+enum class EGPUPass : uint8_t
+{
+    Collision = 0,
+    Sprites,
+    UI,
+
+    COUNT
+};
+
+// Opt-in GPU side of the frame stats: GL_TIME_ELAPSED queries and KHR_debug groups around the passes, and the GL
+// work of each frame (state changes, uploads and readbacks). Query results are only read once available, up to
+// s_latency - 1 frames later, so that the CPU never waits for the GPU: a frame still not available when its slot is
+// needed is dropped. Resolved frames can be written to a CSV file, one line per frame.
+class GPUProfiler : public Singleton<GPUProfiler>
+{
+public:
+    static constexpr size_t      s_historySize = FrameStats::s_historySize;
+    static constexpr const char* s_passNames[] = {"Collision", "Sprites", "UI"};
+
+    struct Frame
+    {
+        float    passes_ms[static_cast<size_t>(EGPUPass::COUNT)] = {}; // GPU time
+        uint32_t stateChangeCount                                = 0;  // Forwarded to GL by GLState
+        uint32_t uploadCount                                     = 0;
+        uint64_t uploadBytes                                     = 0;
+        uint64_t readbackBytes                                   = 0;
+    };
+
+protected:
+    static constexpr size_t s_latency = 4; // Slots of the frames in flight
+
+    struct Query
+    {
+        unsigned int ID;
+        EGPUPass     pass;
+    };
+
+    struct PendingFrame
+    {
+        std::vector<Query> queries;
+        Frame              frame;
+        FrameStats::Frame  CPUFrame;
+        size_t             index; // Since started
+    };
+
+    bool     m_isEnabled         = false;
+    bool     m_hasDebugGroups    = false; // Core since GL 4.3
+    FILE*    m_CSVFile           = nullptr;
+    EGPUPass m_timedPass         = EGPUPass::COUNT; // Time elapsed queries can't be nested
+    uint64_t m_stateChangeStart  = 0;               // GLState forwarded calls at the start of the frame
+    size_t   m_frameCount        = 0;               // Since started
+    size_t   m_nextPendingFrame  = 0;               // Oldest frame in flight
+    size_t   m_droppedFrameCount = 0;               // Results not available in time
+    Frame    m_currentFrame;
+
+    std::vector<unsigned int> m_freeQueries;
+    PendingFrame              m_pendingFrames[s_latency];
+
+    Frame  m_history[s_historySize]; // Resolved frames
+    size_t m_resolvedFrameCount = 0;
+
+protected:
+    // Without waiting
+    bool isAvailable(const PendingFrame& pendingFrame) const;
+
+    void resolve(PendingFrame& pendingFrame);
+
+    void drop(PendingFrame& pendingFrame);
+
+    void writeCSVLine(const PendingFrame& pendingFrame);
+
+public:
+    ~GPUProfiler();
+
+    // CSV file is optional
+    void start(const char* CSVPath);
+
+    // Need the GL context
+    void stop();
+
+    bool isEnabled() const noexcept
+    {
+        return m_isEnabled;
+    }
+
+    // Return true if the pass is timed
+    bool beginPass(EGPUPass pass);
+
+    void endPass(bool isTimed);
+
+    void addUpload(uint64_t bytes) noexcept
+    {
+        ++m_currentFrame.uploadCount;
+        m_currentFrame.uploadBytes += bytes;
+    }
+
+    void addReadback(uint64_t bytes) noexcept
+    {
+        m_currentFrame.readbackBytes += bytes;
+    }
+
+    // Called after FrameStats::endFrame
+    void endFrame();
+
+    size_t getDroppedFrameCount() const noexcept
+    {
+        return m_droppedFrameCount;
+    }
+
+    size_t getHistoryCount() const noexcept
+    {
+        return m_resolvedFrameCount < s_historySize ? m_resolvedFrameCount : s_historySize;
+    }
+
+    // 0 is the oldest frame still in the history
+    const Frame& getFrame(size_t index) const noexcept
+    {
+        const size_t first = m_resolvedFrameCount < s_historySize ? 0 : m_resolvedFrameCount % s_historySize;
+        return m_history[(first + index) % s_historySize];
+    }
+};
+
+// Debug group and GPU time of a pass, if the profiler is enabled
+class GPUPassScope
+{
+protected:
+    bool m_isStarted;
+    bool m_isTimed;
+
+public:
+    GPUPassScope(EGPUPass pass)
+        : m_isStarted{GPUProfiler::instance().isEnabled()},
+          m_isTimed{m_isStarted && GPUProfiler::instance().beginPass(pass)}
+    {
+    }
+
+    ~GPUPassScope()
+    {
+        if (m_isStarted)
+            GPUProfiler::instance().endPass(m_isTimed);
+    }
+
+    GPUPassScope(const GPUPassScope&)            = delete;
+    GPUPassScope& operator=(const GPUPassScope&) = delete;
+};
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "Engine/Graphics/FramebufferOGL.hpp"
+#include "Engine/Graphics/ScreenSpaceQuadOGL.hpp"
+#include "Engine/Graphics/ShaderOGL.hpp"
+#include "Engine/Graphics/TextureOGL.hpp"
+
+#include <memory>
+#include <vector>
+
+// Ordered full screen passes, defined in YAML (see content/setting/edgeDetection.yaml). Each pass samples the output
+// of the previous one, intermediate results alternate between two targets. The last pass writes the output.
+class PostProcess
+{
+protected:
+    struct Pass
+    {
+        std::unique_ptr<Shader> shader;
+        UniformSampler          uTexture;
+        UniformVec2             uResolution;
+        float                   scale = 1.f; // Of the target, relative to the input of the chain
+    };
+
+    std::vector<Pass>        m_passes;
+    std::unique_ptr<Texture> m_targets[2]; // Resized in place when the input size changes
+
+protected:
+    const Texture& getTarget(size_t passIndex, const Texture& input);
+
+public:
+    PostProcess(Window& window, const char* path);
+
+    // Change the bound framebuffer, program, texture and viewport
+    void apply(Framebuffer& framebuffer, ScreenSpaceQuad& quad, const Texture& input, const Texture& output);
+};
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "Engine/FrameStats.hpp"
+#include "Engine/Graphics/GLStateOGL.hpp"
 #include "Engine/Graphics/WindowOGL.hpp"
 #include <glad/glad.h>
 
@@ -11,6 +13,9 @@ protected:
     unsigned int VAO;
     unsigned int EBO;
 
+    // All sprites and passes are drawn with a quad, used by the render benchmark
+    static inline size_t s_drawCallCount = 0;
+
 public:
     ScreenSpaceQuad(Window& win, float minPos = -1.f, float maxPos = 1.f)
     {
@@ -32,7 +37,7 @@ public:
         glGenBuffers(1, &VBO);
         glGenBuffers(1, &EBO);
 
-        glBindVertexArray(VAO);
+        GLState::instance().bindVertexArray(VAO);
 
         glBindBuffer(GL_ARRAY_BUFFER, VBO);
         glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
@@ -51,17 +56,30 @@ public:
     ~ScreenSpaceQuad()
     {
         glDeleteVertexArrays(1, &VAO);
+        GLState::instance().onVertexArrayDeleted(VAO);
         glDeleteBuffers(1, &VBO);
         glDeleteBuffers(1, &EBO);
     }
 
     void use()
     {
-        glBindVertexArray(VAO);
+        GLState::instance().bindVertexArray(VAO);
     }
 
     void draw()
     {
         glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+        ++s_drawCallCount;
+        FrameStats::instance().addDrawCalls(1);
+    }
+
+    static size_t getDrawCallCount() noexcept
+    {
+        return s_drawCallCount;
+    }
+
+    static void resetDrawCallCount() noexcept
+    {
+        s_drawCallCount = 0;
     }
 };
\ No newline at end of file
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "Engine/ClassUtility.hpp"
+#include "Engine/Singleton.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+// Persistent cache of linked program binaries, keyed by shaders source and driver.
+// Avoid the shaders compilation on next launches (slow on software drivers like llvmpipe).
+class ShaderCache : public Singleton<ShaderCache>
+{
+protected:
+    bool                  m_isInit      = false;
+    bool                  m_isSupported = false;
+    std::filesystem::path m_directory;
+    std::string           m_driverIdentifier;
+    int                   m_hitCount  = 0;
+    int                   m_missCount = 0;
+
+protected:
+    // Need a current graphic context
+    void init();
+
+    std::filesystem::path getCachePath(const char* vertexCode, const char* fragmentCode) const;
+
+    bool tryLoadProgram(unsigned int program, const char* vertexCode, const char* fragmentCode);
+
+public:
+    GETTER_BY_VALUE(HitCount, m_hitCount)
+    GETTER_BY_VALUE(MissCount, m_missCount)
+
+    static std::filesystem::path getUserCacheDirectory();
+
+    // Return false if the binary isn't in cache or is rejected by the driver. Program need to be compiled in this case
+    bool loadProgram(unsigned int program, const char* vertexCode, const char* fragmentCode);
+
+    // Program need to be linked with GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+    void saveProgram(unsigned int program, const char* vertexCode, const char* fragmentCode);
+};
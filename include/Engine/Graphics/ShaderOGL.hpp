@@ -1,84 +1,282 @@
 #pragma once
 
 #include "Engine/FileReader.hpp"
+#include "Engine/Graphics/GLStateOGL.hpp"
+#include "Engine/Graphics/ShaderCacheOGL.hpp"
 #include "Engine/Graphics/WindowOGL.hpp"
 
 #include <glad/glad.h>
 #include <stdlib.h>
 
+#include <algorithm>
+#include <string>
+#include <vector>
+
+// Location of a uniform resolved once. Typed so that it can only be set with values of the type declared in GLSL.
+template <GLenum GLType>
+struct UniformHandle
+{
+    static constexpr GLenum s_GLType = GLType;
+
+    int location = -1; // Ignored by glUniform if the uniform doesn't exist
+};
+
+using UniformInt     = UniformHandle<GL_INT>;
+using UniformFloat   = UniformHandle<GL_FLOAT>;
+using UniformVec2    = UniformHandle<GL_FLOAT_VEC2>;
+using UniformVec4    = UniformHandle<GL_FLOAT_VEC4>;
+using UniformSampler = UniformHandle<GL_SAMPLER_2D>;
+
 class Shader
 {
 public:
     unsigned int ID;
 
+protected:
+    struct Uniform
+    {
+        std::string name;
+        int         location;
+        GLenum      type;
+    };
+
+    std::string          m_name;     // Path of the fragment or compute shader, for the reports
+    std::vector<Uniform> m_uniforms; // Outside of the blocks, reflected after the link
+
+#ifdef _DEBUG
+    // Unknown names already reported, name-based setters are called each frame
+    mutable std::vector<std::string> m_reportedUnknownUniforms;
+#endif
+
+public:
+
     // constructor generates the shader on the fly
     // ------------------------------------------------------------------------
     Shader(Window& window, const char* vertexPath, const char* fragmentPath)
     {
         logf("Parse files: %s %s\n", vertexPath, fragmentPath);
+        m_name = fragmentPath;
         FileReader  vertexCodeFile(vertexPath);
         FileReader  fragmentCodeFile(fragmentPath);
         const char* vShaderCode = vertexCodeFile.get();
         const char* fShaderCode = fragmentCodeFile.get();
 
+        ID = glCreateProgram();
+        if (ShaderCache::instance().loadProgram(ID, vShaderCode, fShaderCode))
+        {
+            log("Shader loaded from cache\n");
+            reflectUniforms();
+            return;
+        }
+
         // compile shaders
         unsigned int vertex, fragment;
         // vertex shader
         vertex = glCreateShader(GL_VERTEX_SHADER);
         glShaderSource(vertex, 1, &vShaderCode, NULL);
         glCompileShader(vertex);
-        checkCompileErrors(vertex, "VERTEX");
 
         // fragment Shader
         fragment = glCreateShader(GL_FRAGMENT_SHADER);
         glShaderSource(fragment, 1, &fShaderCode, NULL);
         glCompileShader(fragment);
-        checkCompileErrors(fragment, "FRAGMENT");
 
         // shader Program
-        ID = glCreateProgram();
         glAttachShader(ID, vertex);
         glAttachShader(ID, fragment);
+        glProgramParameteri(ID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
         glLinkProgram(ID);
-        checkCompileErrors(ID, "PROGRAM");
+
+        // Compilation errors make the link fail. Only one status query if everything is fine
+        if (!isLinked(ID))
+        {
+            checkCompileErrors(vertex, "VERTEX");
+            checkCompileErrors(fragment, "FRAGMENT");
+            checkCompileErrors(ID, "PROGRAM");
+        }
 
         // delete the shaders as they're linked into our program now and no longer necessary
+        glDetachShader(ID, vertex);
+        glDetachShader(ID, fragment);
         glDeleteShader(vertex);
         glDeleteShader(fragment);
+
+        ShaderCache::instance().saveProgram(ID, vShaderCode, fShaderCode);
         log("Shader compilation done\n");
+        reflectUniforms();
+    }
+
+    // Compute shader program, need OpenGL 4.3
+    Shader(Window& window, const char* computePath)
+    {
+        logf("Parse file: %s\n", computePath);
+        m_name = computePath;
+        FileReader  computeCodeFile(computePath);
+        const char* cShaderCode = computeCodeFile.get();
+
+        // Cached like a program without fragment shader
+        ID = glCreateProgram();
+        if (ShaderCache::instance().loadProgram(ID, cShaderCode, ""))
+        {
+            log("Shader loaded from cache\n");
+            reflectUniforms();
+            return;
+        }
+
+        unsigned int compute = glCreateShader(GL_COMPUTE_SHADER);
+        glShaderSource(compute, 1, &cShaderCode, NULL);
+        glCompileShader(compute);
+
+        glAttachShader(ID, compute);
+        glProgramParameteri(ID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        glLinkProgram(ID);
+
+        if (!isLinked(ID))
+        {
+            checkCompileErrors(compute, "COMPUTE");
+            checkCompileErrors(ID, "PROGRAM");
+        }
+
+        glDetachShader(ID, compute);
+        glDeleteShader(compute);
+
+        ShaderCache::instance().saveProgram(ID, cShaderCode, "");
+        log("Shader compilation done\n");
+        reflectUniforms();
     }
 
     void use()
     {
-        glUseProgram(ID);
+        GLState::instance().useProgram(ID);
+    }
+
+    // -1 if the program has no such uniform, reported once per name in debug
+    int getUniformLocation(const char* name) const
+    {
+        if (const Uniform* uniform = findUniform(name))
+            return uniform->location;
+
+#ifdef _DEBUG
+        if (std::find(m_reportedUnknownUniforms.begin(), m_reportedUnknownUniforms.end(), name) ==
+            m_reportedUnknownUniforms.end())
+        {
+            m_reportedUnknownUniforms.emplace_back(name);
+            logf(ELogLevel::Warning, "Unknown uniform \"%s\" in %s\n", name, m_name.c_str());
+        }
+#endif
+        return -1;
+    }
+
+    // For the uniforms set often, the type is checked in debug
+    template <typename Handle>
+    Handle getUniform(const char* name) const
+    {
+        Handle handle;
+        handle.location = getUniformLocation(name);
+
+#ifdef _DEBUG
+        const Uniform* uniform = findUniform(name);
+        if (uniform != nullptr && uniform->type != Handle::s_GLType)
+            logf(ELogLevel::Warning, "Uniform \"%s\" of %s has another type in GLSL\n", name, m_name.c_str());
+#endif
+        return handle;
     }
 
     void setBool(const char* name, bool value) const
     {
-        glUniform1i(glGetUniformLocation(ID, name), (int)value);
+        glUniform1i(getUniformLocation(name), (int)value);
     }
 
     void setInt(const char* name, int value) const
     {
-        glUniform1i(glGetUniformLocation(ID, name), value);
+        glUniform1i(getUniformLocation(name), value);
     }
 
     void setVec2(const char* name, float v1, float v2) const noexcept
     {
-        glUniform2f(glGetUniformLocation(ID, name), v1, v2);
+        glUniform2f(getUniformLocation(name), v1, v2);
     }
 
     void setVec4(const char* name, float v1, float v2, float v3, float v4) const noexcept
     {
-        glUniform4f(glGetUniformLocation(ID, name), v1, v2, v3, v4);
+        glUniform4f(getUniformLocation(name), v1, v2, v3, v4);
     }
 
     void setFloat(const char* name, float value) const
     {
-        glUniform1f(glGetUniformLocation(ID, name), value);
+        glUniform1f(getUniformLocation(name), value);
+    }
+
+    // Program need to be used
+    void set(UniformInt uniform, int value) const noexcept
+    {
+        glUniform1i(uniform.location, value);
+    }
+
+    void set(UniformSampler uniform, int textureUnit) const noexcept
+    {
+        glUniform1i(uniform.location, textureUnit);
+    }
+
+    void set(UniformFloat uniform, float value) const noexcept
+    {
+        glUniform1f(uniform.location, value);
+    }
+
+    void set(UniformVec2 uniform, float v1, float v2) const noexcept
+    {
+        glUniform2f(uniform.location, v1, v2);
+    }
+
+    void set(UniformVec4 uniform, float v1, float v2, float v3, float v4) const noexcept
+    {
+        glUniform4f(uniform.location, v1, v2, v3, v4);
+    }
+
+protected:
+    void reflectUniforms()
+    {
+        GLint count = 0;
+        glGetProgramInterfaceiv(ID, GL_UNIFORM, GL_ACTIVE_RESOURCES, &count);
+        m_uniforms.reserve(count);
+
+        static constexpr GLenum s_properties[] = {GL_NAME_LENGTH, GL_TYPE, GL_LOCATION};
+        for (GLint i = 0; i < count; ++i)
+        {
+            GLint values[3];
+            glGetProgramResourceiv(ID, GL_UNIFORM, i, 3, s_properties, 3, nullptr, values);
+
+            // Members of the uniform blocks have no location
+            if (values[2] < 0)
+                continue;
+
+            // Length include the null character
+            std::string name(values[0], '\0');
+            glGetProgramResourceName(ID, GL_UNIFORM, i, values[0], nullptr, name.data());
+            name.resize(values[0] - 1);
+            m_uniforms.push_back({std::move(name), values[2], static_cast<GLenum>(values[1])});
+        }
+    }
+
+    const Uniform* findUniform(const char* name) const noexcept
+    {
+        // Only a few uniforms by program
+        for (const Uniform& uniform : m_uniforms)
+        {
+            if (uniform.name == name)
+                return &uniform;
+        }
+        return nullptr;
     }
 
 private:
+    static bool isLinked(unsigned int program)
+    {
+        int success;
+        glGetProgramiv(program, GL_LINK_STATUS, &success);
+        return success;
+    }
+
     // utility function for checking shader compilation/linking errors.
     void checkCompileErrors(unsigned int shader, const char* type)
     {
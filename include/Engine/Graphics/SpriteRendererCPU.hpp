@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Engine/Graphics/ScreenSpaceQuadOGL.hpp"
+#include "Engine/Graphics/ShaderOGL.hpp"
+#include "Engine/Graphics/TextureOGL.hpp"
+#include "Engine/Graphics/WindowOGL.hpp"
+#include "Engine/SpriteRenderer.hpp"
+
+#include <vector>
+
+// Sprites blended on the CPU in a framebuffer of the window size, from the pixels kept by the textures. The damaged
+// region is then uploaded and copied to the back buffer with a single draw: software OpenGL renderers only run one
+// full screen pass per frame instead of the whole pipeline for each sprite.
+class SpriteRendererCPU : public SpriteRenderer
+{
+protected:
+    Window&          m_window;
+    Shader&          m_imageShader; // Copy of the framebuffer to the back buffer
+    ScreenSpaceQuad& m_fullScreenQuad;
+    Texture          m_target;
+
+    std::vector<unsigned char> m_pixels;       // BGRA, bottom up like the textures
+    std::vector<int>           m_texelColumns; // Of the pixels of the sprite row being blended
+    int                        m_width  = 0;
+    int                        m_height = 0;
+    Canvas::DamageRegion       m_damage; // Upper left origin
+
+public:
+    SpriteRendererCPU(Window& window, Shader& imageShader, ScreenSpaceQuad& fullScreenQuad);
+
+    void beginFrame(const Canvas::DamageRegion& damage) override;
+
+    // Nearest sampling and blending of the OpenGL renderer: same coverage and same result
+    void drawSprite(const Texture& texture, const Rect& rect, float uOffset, float uScale) override;
+
+    void endFrame() override;
+};
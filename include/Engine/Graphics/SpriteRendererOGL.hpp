@@ -0,0 +1,63 @@
+#pragma once
+
+#include "Engine/Graphics/ScreenSpaceQuadOGL.hpp"
+#include "Engine/Graphics/ShaderOGL.hpp"
+#include "Engine/Graphics/TextureOGL.hpp"
+#include "Engine/Graphics/WindowOGL.hpp"
+#include "Engine/SpriteRenderer.hpp"
+
+// Shader of the sprites, with the uniforms set for each sprite resolved once
+class SpriteSheetShader : public Shader
+{
+public:
+    UniformVec4 uScaleOffSet;
+    UniformVec4 uClipSpacePosSize;
+
+    SpriteSheetShader(Window& window, const char* vertexPath, const char* fragmentPath)
+        : Shader(window, vertexPath, fragmentPath), uScaleOffSet{getUniform<UniformVec4>("uScaleOffSet")},
+          uClipSpacePosSize{getUniform<UniformVec4>("uClipSpacePosSize")}
+    {
+    }
+};
+
+// One draw call per sprite, blended by the GPU
+class SpriteRendererOGL : public SpriteRenderer
+{
+protected:
+    Window&            m_window;
+    SpriteSheetShader& m_shader;
+    ScreenSpaceQuad&   m_unitQuad;
+
+public:
+    SpriteRendererOGL(Window& window, SpriteSheetShader& shader, ScreenSpaceQuad& unitQuad)
+        : m_window{window}, m_shader{shader}, m_unitQuad{unitQuad}
+    {
+    }
+
+    void beginFrame(const Canvas::DamageRegion& damage) override
+    {
+        // Scissor test already restrict the draws to the damage
+    }
+
+    void drawSprite(const Texture& texture, const Rect& rect, float uOffset, float uScale) override
+    {
+        Vec2 clipSpacePos = Vec2::remap(rect.getCornerMin(), m_window.getCornerMin(), m_window.getCornerMax(),
+                                        Vec2{0, 1}, Vec2{1, 0}); // [-1, 1]
+        Vec2 clipSpaceSize =
+            Vec2::remap(rect.getSize(), Vec2{0, 0}, m_window.getSize(), Vec2{0, 0}, Vec2{1, 1}); // [0, 1]
+
+        // In shader, based on bottom left instead of upper left
+        clipSpacePos.y -= clipSpaceSize.y;
+
+        m_shader.use();
+        m_shader.set(m_shader.uScaleOffSet, uScale, 1.f, uOffset, 0.f);
+        m_shader.set(m_shader.uClipSpacePosSize, clipSpacePos.x, clipSpacePos.y, clipSpaceSize.x, clipSpaceSize.y);
+        texture.use();
+        m_unitQuad.use();
+        m_unitQuad.draw();
+    }
+
+    void endFrame() override
+    {
+    }
+};
@@ -5,22 +5,36 @@
 #include <vector>
 
 #include "Engine/ClassUtility.hpp"
+#include "Engine/Graphics/GLStateOGL.hpp"
+#include "Engine/Graphics/GPUProfilerOGL.hpp"
 #include "Engine/Log.hpp"
 #include "Engine/Vector2.hpp"
 
 class Texture
 {
 protected:
-    unsigned int ID;
-    int          width, height;
-    int          nbChannels;
-    unsigned char* data = nullptr;
+    // Size of all the texture images, as uploaded
+    static inline size_t s_GPUByteCount = 0;
+
+    unsigned int         ID;
+    int                  width, height;
+    int                  nbChannels;
+    unsigned char*       data         = nullptr;
+    const unsigned char* opacityMask  = nullptr; // Optional, one bit per pixel, mapped from the asset pack
+    bool                 ownsData     = true;    // False if data is mapped from the asset pack
+    size_t               GPUByteCount = 0;
 
 public:
     GETTER_BY_VALUE(ID, ID)
     GETTER_BY_VALUE(Width, width)
     GETTER_BY_VALUE(Height, height)
     GETTER_BY_VALUE(ChannelsCount, nbChannels)
+    GETTER_BY_VALUE(Data, data) // Kept after the upload for the opacity test and the software sprite renderer
+
+    static size_t getTotalGPUByteCount()
+    {
+        return s_GPUByteCount;
+    }
 
     Texture(const char* srcPath, bool verticalFlip = true, std::function<void()> setupCallback = nearestClampSampling);
 
@@ -49,15 +63,31 @@ public:
 
     ~Texture();
 
+    // BGRA data like the data constructor, rowLength in pixels (0 if rows are tightly packed). Storage is only
+    // reallocated if the size changes.
+    void update(const void* pixels, int pxlWidth, int pxlHeight, int rowLength = 0);
+
+    // BGRA data, rowLength in pixels. Region must be inside the texture, the storage is kept.
+    void updateRegion(const void* pixels, int x, int y, int pxlWidth, int pxlHeight, int rowLength);
+
+    // Storage is only reallocated if the size changes, the content is then undefined
+    void resize(int pxlWidth, int pxlHeight);
+
     bool isPixelOpaque(Vec2i cursorPos) const
-    {        
+    {
+        if (opacityMask != nullptr)
+        {
+            const int pixelIndex = cursorPos.x + (height - 1 - cursorPos.y) * width;
+            return (opacityMask[pixelIndex / 8] >> (pixelIndex % 8)) & 1;
+        }
+
         return *(data + (cursorPos.x + (height - 1 - cursorPos.y) * width) * sizeof(unsigned char) * nbChannels +
                  3 * sizeof(unsigned char)) > 0;
     }
 
     void use() const
     {
-        glBindTexture(GL_TEXTURE_2D, ID);
+        GLState::instance().bindTexture(ID);
     }
 
     GLenum getChanelEnum()
@@ -66,16 +96,16 @@ public:
     }
 
     // Warning, texture need to be binding before
+    // Data is resized, its capacity is kept between the calls with the same size
     void getPixels(std::vector<unsigned char>& data)
     {
         int pixelsCount = width * height * nbChannels;
-        data.reserve(pixelsCount);
-
-        for (size_t i = 0; i < pixelsCount; i++)
-        {
-            data.emplace_back(0);
-        }
+        data.resize(pixelsCount);
 
+        // Rows are tightly packed, even if their size isn't a multiple of 4 (ex: single channel)
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
         glGetTextureImage(ID, 0, getChanelEnum(), GL_UNSIGNED_BYTE, pixelsCount * sizeof(unsigned char), &data[0]);
+        glPixelStorei(GL_PACK_ALIGNMENT, 4);
+        GPUProfiler::instance().addReadback(pixelsCount);
     }
 };
\ No newline at end of file
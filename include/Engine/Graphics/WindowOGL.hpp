@@ -6,13 +6,24 @@
 
 class Window : public WindowGLFW
 {
+protected:
+    bool m_usePartialRedraw   = false;
+    bool m_isSoftwareRenderer = false;
+
 protected:
     void initGraphicAPI();
 
+    // Rasterizers running on the CPU (Mesa llvmpipe, SwiftShader, Windows fallback driver...)
+    static bool isSoftwareRenderer(const char* renderer);
+
 public:
+    GETTER_BY_VALUE(IsSoftwareRenderer, m_isSoftwareRenderer)
+
     void init(struct GameData& datas);
 
-    void initDrawContext();
+    // Clear the back buffer. Without full redraw, clear and next draws are restricted to the frame damage.
+    // Return the cleared region.
+    DamageRegion initDrawContext(bool fullRedraw = false);
 
     void setSize(const Vec2 windowSize) noexcept
     {
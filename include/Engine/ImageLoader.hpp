@@ -0,0 +1,75 @@
+#pragma once
+
+#include "Engine/Singleton.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Decode images and read files on a worker pool so that startup can create the window and the graphic context
+// meanwhile. Resources not requested ahead are loaded synchronously when taken.
+class ImageLoader : public Singleton<ImageLoader>
+{
+public:
+    struct Image
+    {
+        // Allocated by stb_image if owned, the receiver need to free it with stbi_image_free.
+        // Else memory mapped from the asset pack.
+        unsigned char*       data        = nullptr;
+        const unsigned char* opacityMask = nullptr; // Optional, one bit per pixel
+        int                  width       = 0;
+        int                  height      = 0;
+        int                  channels    = 0;
+        bool                 isOwned     = true;
+    };
+
+protected:
+    std::mutex                        m_mutex;
+    std::condition_variable           m_condition;
+    std::deque<std::function<void()>> m_tasks;
+    std::vector<std::thread>          m_workers;
+    bool                              m_shouldStop = false;
+
+    std::map<std::string, std::future<Image>>             m_pendingImages;
+    std::map<std::string, std::future<std::vector<char>>> m_pendingFiles;
+
+protected:
+    static std::string imageKey(const std::string& path, bool verticalFlip)
+    {
+        return path + (verticalFlip ? "|flip" : "");
+    }
+
+    void workerLoop();
+
+    void pushTask(std::function<void()> task);
+
+public:
+    ~ImageLoader();
+
+    // Without worker, requests are ignored and resources are loaded when taken
+    void start(unsigned int workerCount);
+
+    void stop();
+
+    static Image decode(const char* path, bool verticalFlip);
+
+    // Take the image from the asset pack if available, else decode it
+    static Image load(const char* path, bool verticalFlip);
+
+    static std::vector<char> readFile(const char* path);
+
+    void requestImage(const std::string& path, bool verticalFlip);
+
+    void requestFile(const std::string& path);
+
+    // Wait for the decoding if it was requested or decode it on the current thread
+    Image takeImage(const std::string& path, bool verticalFlip);
+
+    std::vector<char> takeFile(const std::string& path);
+};
@@ -14,18 +14,20 @@ public:
     std::function<void()> onMouseOver;
     std::function<void()> onLeftPressOver;
     std::function<void()> onLeftReleaseOver;
+    std::function<void()> onLeftRelease; // Even if the cursor isn't over anymore
     std::function<void()> onRightPressOver;
     std::function<void()> onRightReleaseOver;
 
-    bool isLeftSelected;
-    bool isRightSelected;
+    bool isLeftSelected  = false;
+    bool isRightSelected = false;
+    bool isDraggable     = false; // Rect follows the cursor while left selected
 
     // One frame
-    bool isMouseOver;
-    bool isLeftPressOver;
-    bool isLeftRelease;
-    bool isRightPressOver;
-    bool isRightRelease;
+    bool isMouseOver      = false;
+    bool isLeftPressOver  = false;
+    bool isLeftRelease    = false;
+    bool isRightPressOver = false;
+    bool isRightRelease   = false;
 
 public:
     DEFAULT_GETTER_SETTER_VALUE(Rect, m_rect)
@@ -2,10 +2,12 @@
 
 #include "Engine/Graphics/WindowOGL.hpp"
 #include "Engine/InteractionComponent.hpp"
+#include "Engine/Profiler.hpp"
 #include "Engine/Rect.hpp"
 #include "Engine/Vector2.hpp"
 #include "Game/GameData.hpp"
 
+#include <algorithm>
 #include <list>
 
 class InteractionSystem
@@ -24,8 +26,26 @@ public:
         m_components.remove_if([&](auto inComp) { return inComp == &comp; });
     }
 
+    bool isDragging() const
+    {
+        return std::any_of(m_components.begin(), m_components.end(),
+                           [](const InteractionComponent* comp) { return comp->isDraggable && comp->isLeftSelected; });
+    }
+
+    // Move the rect of the draggable selected components
+    void applyDrag(Vec2 delta)
+    {
+        for (InteractionComponent* comp : m_components)
+        {
+            if (comp->isDraggable && comp->isLeftSelected)
+                comp->getRect().setPosition(comp->getRect().getPosition() + delta);
+        }
+    }
+
     void update(GameData& data)
     {
+        PROFILE_SCOPE("InteractionSystem::update");
+
         bool shouldMousePassThough = true;
         bool isLeftClickConsumed   = false;
         bool isRightClickConsumed  = false;
@@ -64,6 +84,9 @@ public:
                 comp->isLeftSelected = false;
                 comp->isLeftRelease  = true;
 
+                if (comp->onLeftRelease != nullptr)
+                    comp->onLeftRelease();
+
                 if (comp->isMouseOver)
                 {
                     if (comp->onLeftReleaseOver != nullptr)
@@ -1,32 +1,61 @@
 #pragma once
 
+#include "Engine/Logger.hpp"
+
 #include "boxer/boxer.h"
 
 #include <cstdarg>
 #include <stdio.h>
 #include <string>
 
-inline void log(const char* buffer)
+// Format need to be a string literal, see Logger
+inline void vlogf(ELogLevel level, char const* const format, va_list arglist)
 {
-#if _DEBUG
-    // log into console
-    fputs(buffer, stderr);
-#endif
+    if (Logger::isAvailable())
+        Logger::instance().write(level, format, arglist);
+    else
+        vfprintf(stderr, format, arglist); // During the static destruction
+}
+
+inline void logf(ELogLevel level, char const* const format, ...)
+{
+    va_list arglist;
+    va_start(arglist, format);
+    vlogf(level, format, arglist);
+    va_end(arglist);
 }
 
 inline void logf(char const* const format, ...)
 {
     va_list arglist;
     va_start(arglist, format);
-#if _DEBUG
-    // log into console
-    vfprintf(stderr, format, arglist);
-#endif
+    vlogf(ELogLevel::Info, format, arglist);
     va_end(arglist);
 }
 
+// Format need to be a string literal whose only argument is the text, rate limited by text instead of by format
+inline void logText(ELogLevel level, char const* const format, const char* text)
+{
+    if (Logger::isAvailable())
+        Logger::instance().writeText(level, format, text);
+    else
+        fprintf(stderr, format, text); // During the static destruction
+}
+
+// Text can be temporary, it is copied
+inline void log(ELogLevel level, const char* buffer)
+{
+    logText(level, "%s", buffer);
+}
+
+inline void log(const char* buffer)
+{
+    log(ELogLevel::Info, buffer);
+}
+
 inline void errorAndExit(const std::string& msg)
 {
+    logText(ELogLevel::Error, "%s\n", msg.c_str());
     boxer::Selection selection =
         boxer::show(msg.c_str(), PROJECT_NAME " error", boxer::Style::Error, boxer::Buttons::OK);
     exit(-1);
@@ -34,6 +63,7 @@ inline void errorAndExit(const std::string& msg)
 
 inline void warning(const std::string& msg)
 {
+    logText(ELogLevel::Warning, "%s\n", msg.c_str());
     boxer::show(msg.c_str(), PROJECT_NAME " warning", boxer::Style::Warning, boxer::Buttons::OK);
 }
 
@@ -47,6 +77,7 @@ inline void GLDebugMessageCallback(GLenum source, GLenum type, GLuint id, GLenum
     const char* _source;
     const char* _type;
     const char* _severity;
+    ELogLevel   level;
 
     switch (source)
     {
@@ -118,14 +149,17 @@ inline void GLDebugMessageCallback(GLenum source, GLenum type, GLuint id, GLenum
     {
     case GL_DEBUG_SEVERITY_HIGH:
         _severity = "HIGH";
+        level     = ELogLevel::Error;
         break;
 
     case GL_DEBUG_SEVERITY_MEDIUM:
         _severity = "MEDIUM";
+        level     = ELogLevel::Warning;
         break;
 
     case GL_DEBUG_SEVERITY_LOW:
         _severity = "LOW";
+        level     = ELogLevel::Info;
         break;
 
     case GL_DEBUG_SEVERITY_NOTIFICATION:
@@ -134,9 +168,10 @@ inline void GLDebugMessageCallback(GLenum source, GLenum type, GLuint id, GLenum
 
     default:
         _severity = "UNKNOWN";
+        level     = ELogLevel::Warning;
         break;
     }
 
-    logf("%d: %s of %s severity, raised from %s: %s\n", id, _type, _severity, _source, msg);
+    logf(level, "%d: %s of %s severity, raised from %s: %s\n", id, _type, _severity, _source, msg);
 }
 #endif
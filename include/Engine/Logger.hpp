@@ -0,0 +1,165 @@
+#pragma once
+
+#include "Engine/Singleton.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+enum class ELogLevel : uint8_t
+{
+    Debug = 0,
+    Info,
+    Warning,
+    Error,
+
+    COUNT
+};
+
+// Each thread writes its messages in its own ring, a background thread formats them and writes them to stderr and to
+// a rotating file. The calling thread only copies the format pointer and the arguments, so formats need to be string
+// literals. A full ring drops the message instead of blocking, and each format (or text, see writeText) is limited to
+// s_maxMessagesPerSecond per thread. Errors are never rate limited. Without message, the background thread sleeps.
+class Logger : public Singleton<Logger>
+{
+public:
+    static constexpr const char* s_levelNames[] = {"Debug", "Info", "Warning", "Error"};
+
+#ifdef _DEBUG
+    static constexpr ELogLevel s_defaultMinLevel = ELogLevel::Debug;
+#else
+    static constexpr ELogLevel s_defaultMinLevel = ELogLevel::Info;
+#endif
+
+    static constexpr size_t                    s_recordSize           = 512;
+    static constexpr size_t                    s_ringCapacity         = 256; // Records per thread, power of two
+    static constexpr uint32_t                  s_maxMessagesPerSecond = 20;
+    static constexpr uintmax_t                 s_maxFileSize          = 1 << 20; // Rotated when bigger
+    static constexpr int                       s_rotatedFileCount     = 3;
+    static constexpr std::chrono::milliseconds s_flushTimeout{10000}; // Safety net, the flusher is notified
+
+    struct Record
+    {
+        int64_t       time_ns;
+        const char*   format;
+        uint32_t      suppressedCount; // Messages of this format dropped by the rate limit before this one
+        uint16_t      argsSize;
+        ELogLevel     level;
+        unsigned char args[s_recordSize - 23]; // Arguments encoded by the calling thread
+    };
+    static_assert(sizeof(Record) == s_recordSize);
+
+protected:
+    struct RateLimit
+    {
+        uint64_t    key             = 0; // Format pointer or text hash
+        int64_t     windowStart_ns  = 0;
+        uint32_t    count           = 0;
+        uint32_t    suppressedCount = 0;
+    };
+
+    struct ThreadBuffer
+    {
+        static constexpr size_t s_rateLimitCount = 64; // Keys sharing a slot reset each other limit
+
+        std::unique_ptr<Record[]> records      = std::make_unique<Record[]>(s_ringCapacity);
+        std::atomic<uint64_t>     writeCount   = 0; // Written by the thread
+        std::atomic<uint64_t>     readCount    = 0; // Written by the flusher
+        std::atomic<uint32_t>     droppedCount = 0;
+        RateLimit                 rateLimits[s_rateLimitCount]; // Only used by the thread
+    };
+
+    static inline std::atomic<bool> s_isDestroyed = false;
+
+    const std::chrono::steady_clock::time_point m_start    = std::chrono::steady_clock::now();
+    std::atomic<ELogLevel>                      m_minLevel = s_defaultMinLevel;
+
+    // Kept after the thread exit so that its last messages are still written
+    std::mutex                                 m_threadBuffersMutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> m_threadBuffers;
+
+    // Only used by the flusher
+    std::filesystem::path m_filePath;
+    FILE*                 m_file     = nullptr;
+    uintmax_t             m_fileSize = 0;
+
+    std::mutex              m_mutex;
+    std::condition_variable m_condition;
+    std::atomic<bool>       m_isFlushRequested = false; // Set by the first record written since the last flush
+    bool                    m_shouldStop       = false;
+    std::thread             m_flusher;
+
+protected:
+    int64_t getTime_ns() const noexcept
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_start)
+            .count();
+    }
+
+    ThreadBuffer* registerThread();
+
+    ThreadBuffer& getThreadBuffer()
+    {
+        thread_local ThreadBuffer* buffer = registerThread();
+        return *buffer;
+    }
+
+    bool isRateLimited(ThreadBuffer& buffer, uint64_t key, int64_t time_ns, uint32_t& suppressedCount);
+
+    void write(ELogLevel level, uint64_t rateLimitKey, const char* format, va_list args);
+
+    void flushLoop();
+
+    void flush();
+
+    void writeRecord(const Record& record);
+
+    void writeLine(ELogLevel level, int64_t time_ns, const char* text, size_t size);
+
+    // Move the previous files to make room for a new one
+    void openFile();
+
+public:
+    Logger();
+
+    ~Logger();
+
+    // False during the static destruction, once the logger is destroyed
+    static bool isAvailable() noexcept
+    {
+        return !s_isDestroyed.load(std::memory_order_acquire);
+    }
+
+    static std::filesystem::path getLogDirectory();
+
+    static ELogLevel parseLevel(const std::string& name, ELogLevel defaultLevel);
+
+    ELogLevel getMinLevel() const noexcept
+    {
+        return m_minLevel.load(std::memory_order_relaxed);
+    }
+
+    void setMinLevel(ELogLevel level) noexcept
+    {
+        m_minLevel.store(level, std::memory_order_relaxed);
+    }
+
+    // Format need to be a string literal, rate limited by format
+    void write(ELogLevel level, const char* format, va_list args)
+    {
+        write(level, reinterpret_cast<uintptr_t>(format), format, args);
+    }
+
+    // Format need to be a string literal whose only argument is a text, rate limited by text so that the messages
+    // sharing the format of a wrapper (ex: log, warning) don't share their limit
+    void writeText(ELogLevel level, const char* format, ...);
+};
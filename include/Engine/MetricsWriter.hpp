@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+// Metrics in the Prometheus text exposition format. The file is written next to its destination then renamed, so
+// that a scraper (ex: the textfile collector of node_exporter) never reads a partial file.
+class MetricsWriter
+{
+protected:
+    std::string m_text; // Reused by each write
+
+protected:
+    void addHeader(const char* name, const char* help, const char* type);
+
+public:
+    void addGauge(const char* name, const char* help, double value);
+
+    // Name should end with _total
+    void addCounter(const char* name, const char* help, double value);
+
+    // bucketCounts[i] is the number of observations lower or equal to bounds[i], the +Inf bucket is count
+    void addHistogram(const char* name, const char* help, const double* bounds, const uint64_t* bucketCounts,
+                      size_t bucketCount, uint64_t count, double sum);
+
+    // Write and clear the metrics added since the last write
+    bool writeFile(const std::filesystem::path& path);
+};
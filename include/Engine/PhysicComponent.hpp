@@ -4,6 +4,8 @@
 #include "Engine/Vector2.hpp"
 #include "Engine/Rect.hpp"
 
+#include <functional>
+
 class PhysicComponent
 {
 protected:
@@ -19,6 +21,10 @@ public:
     bool  isOnBottomOfWindow  = false;
     bool  isGrounded          = false;
 
+    // Called by the physic system at the end of its update
+    std::function<void()> onGroundedChanged;
+    std::function<void()> onTouchScreenEdgeChanged;
+
     PhysicComponent(Rect& rect) : m_rect{rect}
     {
 
@@ -7,22 +7,43 @@
 #include "Engine/Graphics/FramebufferOGL.hpp"
 #include "Engine/Graphics/ShaderOGL.hpp"
 #include "Engine/Graphics/ScreenSpaceQuadOGL.hpp"
+#include "Engine/Graphics/CollisionQueryOGL.hpp"
+#include "Engine/Graphics/PostProcessOGL.hpp"
+#include "Engine/Graphics/GPUProfilerOGL.hpp"
 #endif // USE_OPENGL_API
 
 #include "Engine/Vector2.hpp"
 #include "Engine/PhysicComponent.hpp"
+#include "Engine/ClassUtility.hpp"
+#include "Engine/FrameStats.hpp"
 #include "Engine/InteractionComponent.hpp"
+#include "Engine/Profiler.hpp"
 #include "Engine/Rect.hpp"
+#include "Engine/TimeManager.hpp"
 #include "Game/GameData.hpp"
 
 #include <cmath>
+#include <vector>
 
 class PhysicSystem
 {
 protected:
     GameData& data;
 
+    // Since the start
+    uint64_t m_updateCount      = 0;
+    uint64_t m_captureByteCount = 0;
+
+    // Scratch buffers reused by each update
+    ScreenShoot                m_screenShoot;
+    std::vector<unsigned char> m_pixels;
+    std::vector<Vec2i>         m_monitorsPosition;
+    std::vector<Vec2i>         m_monitorsSize;
+
 public:
+    GETTER_BY_VALUE(UpdateCount, m_updateCount)
+    GETTER_BY_VALUE(CaptureByteCount, m_captureByteCount)
+
     PhysicSystem(GameData& data) : data{data}
     {
     }
@@ -52,16 +73,17 @@ public:
 
     void computeMonitorCollisions(PhysicComponent& comp)
     {
-        std::vector<Vec2i> monitorsPosition;
-        std::vector<Vec2i> monitorSize;
-        bool               isOutside          = true;
-        int                screenOverlapCount = 0;
+        std::vector<Vec2i>& monitorsPosition   = m_monitorsPosition;
+        std::vector<Vec2i>& monitorSize        = m_monitorsSize;
+        bool                isOutside          = true;
+        int                 screenOverlapCount = 0;
+
+        monitorsPosition.resize(data.monitors.getMonitorsCount());
+        monitorSize.resize(data.monitors.getMonitorsCount());
 
         // 1: Check if pet is outside of all monitors
         for (int i = 0; i < data.monitors.getMonitorsCount(); ++i)
         {
-            monitorsPosition.emplace_back();
-            monitorSize.emplace_back();
             data.monitors.getMonitorPosition(i, monitorsPosition[i]);
             data.monitors.getMonitorSize(i, monitorSize[i]);
             bool isOutsideOfCurrentMonitor =
@@ -152,52 +174,30 @@ public:
             screenShootSizeY = static_cast<int>(abs(prevToNewWinPos.y) + data.footBasementHeight);
         }
 
-        ScreenShoot              screenshoot(screenShootPosX, screenShootPosY, screenShootSizeX, screenShootSizeY);
-        const ScreenShoot::Data& pxlData = screenshoot.get();
+        const ScreenShoot::Data& pxlData =
+            m_screenShoot.capture(screenShootPosX, screenShootPosY, screenShootSizeX, screenShootSizeY);
+        m_captureByteCount += static_cast<uint64_t>(pxlData.width) * pxlData.height * 4;
+
+        PROFILE_SCOPE("Edge detection");
+        FrameStageTimer stageTimer(EFrameStage::EdgeDetection);
 
-        data.pCollisionTexture     = std::make_unique<Texture>(pxlData.bits, pxlData.width, pxlData.height, 4);
-        data.pEdgeDetectionTexture = std::make_unique<Texture>(pxlData.width, pxlData.height, 4);
+        // Created once, then updated in place
+        if (!data.pCollisionTexture)
+            data.pCollisionTexture = std::make_unique<Texture>(pxlData.width, pxlData.height, 4);
+        data.pCollisionTexture->update(pxlData.bits, pxlData.width, pxlData.height, pxlData.rowLength);
+
+        // The edge pass only writes the red channel: R8 target, a quarter of the RGBA readback
+        if (!data.pEdgeDetectionTexture)
+            data.pEdgeDetectionTexture = std::make_unique<Texture>(pxlData.width, pxlData.height, 1);
+        data.pEdgeDetectionTexture->resize(pxlData.width, pxlData.height);
 
 #if USE_OPENGL_API
-        glDisable(GL_BLEND);
-        glViewport(0, 0, pxlData.width, pxlData.height);
+        GLState::instance().setCapability(GLState::ECapability::Blend, false);
+        GLState::instance().setCapability(GLState::ECapability::ScissorTest, false);
 #endif
 
-        if (data.edgeDetectionShaders.size() == 1)
-        {
-            data.pFramebuffer->bind();
-            data.pFramebuffer->attachTexture(*data.pEdgeDetectionTexture);
-
-            data.edgeDetectionShaders[0]->use();
-            data.edgeDetectionShaders[0]->setInt("uTexture", 0);
-            data.edgeDetectionShaders[0]->setVec2("resolution", static_cast<float>(pxlData.width),
-                                                 static_cast<float>(pxlData.height));
-            data.pCollisionTexture->use();
-            data.pFullScreenQuad->use();
-            data.pFullScreenQuad->draw();
-        }
-        else
-        {
-            data.pFramebuffer->bind();
-            data.pFramebuffer->attachTexture(*data.pCollisionTexture);
-
-            data.edgeDetectionShaders[0]->use();
-            data.edgeDetectionShaders[0]->setInt("uTexture", 0);
-            data.pCollisionTexture->use();
-            data.pFullScreenQuad->use();
-            data.pFullScreenQuad->draw();
-
-            data.pFramebuffer->bind();
-            data.pFramebuffer->attachTexture(*data.pEdgeDetectionTexture);
-
-            data.edgeDetectionShaders[1]->use();
-            data.edgeDetectionShaders[1]->setInt("uTexture", 0);
-            data.edgeDetectionShaders[1]->setVec2("resolution", static_cast<float>(pxlData.width),
-                                                 static_cast<float>(pxlData.height));
-            data.pCollisionTexture->use();
-            data.pFullScreenQuad->use();
-            data.pFullScreenQuad->draw();
-        }
+        data.pEdgeDetection->apply(*data.pFramebuffer, *data.pFullScreenQuad, *data.pCollisionTexture,
+                                   *data.pEdgeDetectionTexture);
     }
 
     bool processContinuousCollision(const PhysicComponent& comp, const Vec2 prevToNewWinPos, Vec2& newPos)
@@ -211,14 +211,10 @@ public:
         if (prevToNewWinPos.sqrLength() == 0.f)
             return false;
 
+        // Upload, edge detection and query or readback
+        GPUPassScope collisionPass(EGPUPass::Collision);
         updateCollisionTexture(comp, prevToNewWinPos);
 
-        std::vector<unsigned char> pixels;
-        data.pEdgeDetectionTexture->use();
-        data.pEdgeDetectionTexture->getPixels(pixels);
-
-        int dataPerPixel = data.pEdgeDetectionTexture->getChannelsCount();
-
         bool iterationOnX = abs(prevToNewWinPos.x) > abs(prevToNewWinPos.y);
         Vec2 prevToNewWinPosDir;
 
@@ -238,6 +234,34 @@ public:
         float column = prevToNewWinPosDir.x < 0.f ? width - data.footBasementWidth : 0.f;
 
         int iterationCount = iterationOnX ? width - data.footBasementWidth : height - data.footBasementHeight;
+
+        // Only the index of the first colliding step is read back
+        if (data.pCollisionQuery)
+        {
+            PROFILE_SCOPE("Collision query");
+            FrameStageTimer stageTimer(EFrameStage::EdgeDetection);
+            const Vec2 start(column, row);
+            const int  hitStep =
+                data.pCollisionQuery->query(*data.pEdgeDetectionTexture, start, prevToNewWinPosDir, iterationCount + 1,
+                                            data.footBasementWidth, data.footBasementHeight,
+                                            data.collisionPixelRatioStopMovement);
+            if (hitStep < 0)
+                return false;
+
+            newPos = comp.getRect().getPosition() + start + prevToNewWinPosDir * static_cast<float>(hitStep);
+            return true;
+        }
+
+        std::vector<unsigned char>& pixels = m_pixels;
+        {
+            PROFILE_SCOPE("Collision readback");
+            FrameStageTimer stageTimer(EFrameStage::EdgeDetection);
+            data.pEdgeDetectionTexture->use();
+            data.pEdgeDetectionTexture->getPixels(pixels);
+        }
+
+        int dataPerPixel = data.pEdgeDetectionTexture->getChannelsCount();
+
         for (int i = 0; i < iterationCount + 1; i++)
         {
             float count = 0;
@@ -271,12 +295,35 @@ public:
     }
 
     void update(PhysicComponent& comp, InteractionComponent& interactionComp, double deltaTime)
+    {
+        PROFILE_SCOPE("PhysicSystem::update");
+        FrameStageTimer stageTimer(EFrameStage::Physic);
+        ++m_updateCount;
+
+        const bool wasGrounded     = comp.isGrounded;
+        const bool wasTouchingEdge = comp.touchScreenEdge;
+
+        integrate(comp, interactionComp, deltaTime);
+
+        if (wasGrounded != comp.isGrounded && comp.onGroundedChanged != nullptr)
+            comp.onGroundedChanged();
+
+        if (wasTouchingEdge != comp.touchScreenEdge && comp.onTouchScreenEdgeChanged != nullptr)
+            comp.onTouchScreenEdgeChanged();
+    }
+
+    void integrate(PhysicComponent& comp, InteractionComponent& interactionComp, double deltaTime)
     {
         // Apply gravity if not selected
         if (interactionComp.isLeftSelected)
         {
+            // Usually already applied by the cursor callback with the immediate drag
             Vec2 movement = {data.deltaCursorPosX, data.deltaCursorPosY};
-            comp.getRect().setPosition(comp.getRect().getPosition() + movement);
+            if (movement.x != 0.f || movement.y != 0.f)
+            {
+                comp.getRect().setPosition(comp.getRect().getPosition() + movement);
+                TimeManager::instance().markInputApplied();
+            }
 
             data.deltaCursorPosX = 0;
             data.deltaCursorPosY = 0;
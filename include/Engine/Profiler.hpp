@@ -0,0 +1,115 @@
+#pragma once
+
+// Scoped zones recorded per thread and saved as a Chrome trace, readable with chrome://tracing or ui.perfetto.dev.
+// Compiled out unless USE_PROFILER is defined (CMake option USE_PROFILER).
+#ifdef USE_PROFILER
+
+#include "Engine/Singleton.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class Profiler : public Singleton<Profiler>
+{
+public:
+    struct Zone
+    {
+        const char* name     = nullptr; // Static string
+        int64_t     begin_ns = 0;
+        int64_t     end_ns   = 0;
+    };
+
+    // Only written by its thread, the oldest zones are overwritten when full
+    struct ThreadBuffer
+    {
+        static constexpr size_t s_capacity = 1 << 16;
+
+        std::unique_ptr<Zone[]> zones       = std::make_unique<Zone[]>(s_capacity);
+        std::atomic<uint64_t>   zoneCount   = 0;
+        uint32_t                threadIndex = 0;
+        const char*             threadName  = "Thread"; // Static string
+    };
+
+protected:
+    const std::chrono::steady_clock::time_point m_start = std::chrono::steady_clock::now();
+
+    // Kept after the thread exit so that its zones are still saved
+    std::mutex                                 m_threadBuffersMutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> m_threadBuffers;
+
+protected:
+    ThreadBuffer* registerThread()
+    {
+        std::lock_guard<std::mutex> lock(m_threadBuffersMutex);
+        ThreadBuffer& buffer = *m_threadBuffers.emplace_back(std::make_unique<ThreadBuffer>());
+        buffer.threadIndex   = static_cast<uint32_t>(m_threadBuffers.size() - 1);
+        return &buffer;
+    }
+
+    ThreadBuffer& getThreadBuffer()
+    {
+        thread_local ThreadBuffer* buffer = registerThread();
+        return *buffer;
+    }
+
+public:
+    // Since the profiler creation
+    int64_t getTime_ns() const noexcept
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_start)
+            .count();
+    }
+
+    void setThreadName(const char* name) noexcept
+    {
+        getThreadBuffer().threadName = name;
+    }
+
+    void record(const char* name, int64_t begin_ns, int64_t end_ns) noexcept
+    {
+        ThreadBuffer&  buffer = getThreadBuffer();
+        const uint64_t count  = buffer.zoneCount.load(std::memory_order_relaxed);
+        buffer.zones[count & (ThreadBuffer::s_capacity - 1)] = {name, begin_ns, end_ns};
+        buffer.zoneCount.store(count + 1, std::memory_order_release);
+    }
+
+    // Save the zones still in the buffers of all the threads
+    bool saveChromeTrace(const char* path);
+};
+
+class ProfilerZone
+{
+protected:
+    const char* m_name;
+    int64_t     m_begin_ns;
+
+public:
+    explicit ProfilerZone(const char* name) noexcept : m_name{name}, m_begin_ns{Profiler::instance().getTime_ns()}
+    {
+    }
+
+    ProfilerZone(const ProfilerZone&)            = delete;
+    ProfilerZone& operator=(const ProfilerZone&) = delete;
+
+    ~ProfilerZone()
+    {
+        Profiler& profiler = Profiler::instance();
+        profiler.record(m_name, m_begin_ns, profiler.getTime_ns());
+    }
+};
+
+#define PROFILER_CONCAT_IMPL(a, b) a##b
+#define PROFILER_CONCAT(a, b)      PROFILER_CONCAT_IMPL(a, b)
+#define PROFILE_SCOPE(name)        ProfilerZone PROFILER_CONCAT(profilerZone, __LINE__)(name)
+#define PROFILE_THREAD(name)       Profiler::instance().setThreadName(name)
+
+#else
+
+#define PROFILE_SCOPE(name)
+#define PROFILE_THREAD(name)
+
+#endif // USE_PROFILER
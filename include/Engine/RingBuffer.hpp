@@ -0,0 +1,67 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+// Fixed capacity lock-free queue for one producer thread and one consumer thread. Elements are never allocated, the
+// producer fails to push when the consumer is late by the whole capacity.
+template <typename T, size_t TCapacity>
+class SPSCRingBuffer
+{
+    static_assert(TCapacity != 0 && (TCapacity & (TCapacity - 1)) == 0, "Capacity need to be a power of two");
+
+protected:
+    T m_elements[TCapacity];
+
+    // Indices are not wrapped, the slot is the index modulo the capacity
+    alignas(64) std::atomic<size_t> m_head{0}; // Written by the consumer
+    alignas(64) std::atomic<size_t> m_tail{0}; // Written by the producer
+
+public:
+    static constexpr size_t capacity() noexcept
+    {
+        return TCapacity;
+    }
+
+    // Producer only
+    bool tryPush(const T& element) noexcept
+    {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head.load(std::memory_order_acquire) == TCapacity)
+            return false;
+
+        m_elements[tail & (TCapacity - 1)] = element;
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer only
+    size_t size() const noexcept
+    {
+        return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_relaxed);
+    }
+
+    // Consumer only
+    bool empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+    // Consumer only, 0 is the oldest element. Index need to be lower than size()
+    const T& operator[](size_t index) const noexcept
+    {
+        return m_elements[(m_head.load(std::memory_order_relaxed) + index) & (TCapacity - 1)];
+    }
+
+    // Consumer only
+    void pop(size_t count = 1) noexcept
+    {
+        m_head.store(m_head.load(std::memory_order_relaxed) + count, std::memory_order_release);
+    }
+
+    // Consumer only
+    void clear() noexcept
+    {
+        m_head.store(m_tail.load(std::memory_order_acquire), std::memory_order_release);
+    }
+};
@@ -1,10 +1,16 @@
 #pragma once
 
-#ifdef __linux__
-#elif _WIN32
+#include "Engine/FrameStats.hpp"
+#include "Engine/Profiler.hpp"
+
+#ifdef _WIN32
 #define NOMINMAX
 #include <Windows.h>
 
+#include <algorithm>
+#include <cstdio>
+
+// Kept between the captures: the bitmap is a DIB section that only grows, so a capture doesn't allocate
 class ScreenShoot
 {
 public:
@@ -13,96 +19,163 @@ public:
         unsigned int width       = 0;
         unsigned int height      = 0;
         unsigned int bitPerPixel = 0;
+        unsigned int rowLength   = 0; // In pixels, rows are bottom-up
         void*        bits        = nullptr;
     };
 
 protected:
-    HDC     hScreen = nullptr;
-    HDC     hDC     = nullptr;
-    HBITMAP hBitmap = nullptr;
-    HGDIOBJ old_obj = nullptr;
-    HGLOBAL  hDIB    = nullptr;
+    HDC     hDC          = nullptr;
+    HBITMAP hBitmap      = nullptr;
+    HGDIOBJ old_obj      = nullptr;
+    void*   bitmapBits   = nullptr;
+    int     bitmapWidth  = 0;
+    int     bitmapHeight = 0;
 
     Data data;
 
-public:
-    ScreenShoot(int x, int y, int w, int h, bool saveIntoClipboard = false)
+protected:
+    void releaseBitmap()
     {
-        if (w * h == 0)
+        if (hBitmap == nullptr)
             return;
 
-        // https://docs.microsoft.com/fr-fr/windows/win32/gdi/capturing-an-image
-        // https://stackoverflow.com/a/28248531
-        // copy screen to bitmap
-        hScreen = GetDC(NULL);
-        hDC     = CreateCompatibleDC(hScreen);
-        hBitmap = CreateCompatibleBitmap(hScreen, w, h);
-        old_obj = SelectObject(hDC, hBitmap);
+        SelectObject(hDC, old_obj);
+        DeleteObject(hBitmap);
+        hBitmap    = nullptr;
+        bitmapBits = nullptr;
+    }
 
-        if (!BitBlt(hDC, 0, 0, w, h, hScreen, x, y, SRCCOPY))
+    bool reserve(HDC hScreen, int w, int h)
+    {
+        if (w <= bitmapWidth && h <= bitmapHeight)
+            return true;
+
+        releaseBitmap();
+        bitmapWidth  = std::max(w, bitmapWidth);
+        bitmapHeight = std::max(h, bitmapHeight);
+
+        // Positive height: bottom-up rows, same origin than the textures
+        BITMAPINFO bi{};
+        bi.bmiHeader.biSize        = sizeof(BITMAPINFOHEADER);
+        bi.bmiHeader.biWidth       = bitmapWidth;
+        bi.bmiHeader.biHeight      = bitmapHeight;
+        bi.bmiHeader.biPlanes      = 1;
+        bi.bmiHeader.biBitCount    = 32;
+        bi.bmiHeader.biCompression = BI_RGB;
+
+        if (hDC == nullptr)
+            hDC = CreateCompatibleDC(hScreen);
+        hBitmap = CreateDIBSection(hScreen, &bi, DIB_RGB_COLORS, &bitmapBits, nullptr, 0);
+        if (hBitmap == nullptr)
         {
-            puts("BitBlt has failed");
+            bitmapWidth  = 0;
+            bitmapHeight = 0;
+            return false;
         }
+        old_obj = SelectObject(hDC, hBitmap);
+        return true;
+    }
 
-        if (saveIntoClipboard)
-        {
-            // save bitmap to clipboard
-            OpenClipboard(NULL);
-            EmptyClipboard();
-            SetClipboardData(CF_BITMAP, hBitmap);
-            CloseClipboard();
-        }
+public:
+    ScreenShoot() = default;
 
-        BITMAP bitmap;
-        GetObject(hBitmap, sizeof(BITMAP), &bitmap);
-
-        BITMAPINFOHEADER bi;
-
-        bi.biSize          = sizeof(BITMAPINFOHEADER);
-        bi.biWidth         = bitmap.bmWidth;
-        bi.biHeight        = bitmap.bmHeight;
-        bi.biPlanes        = bitmap.bmPlanes;
-        bi.biBitCount      = bitmap.bmBitsPixel;
-        bi.biCompression   = BI_RGB;
-        bi.biSizeImage     = 0;
-        bi.biXPelsPerMeter = 0;
-        bi.biYPelsPerMeter = 0;
-        bi.biClrUsed       = 0;
-        bi.biClrImportant  = 0;
-
-        DWORD dwBmpSize = ((bitmap.bmWidth * bi.biBitCount + bi.biBitCount - 1) / bi.biBitCount) * 4 * bitmap.bmHeight;
-
-        // Starting with 32-bit Windows, GlobalAlloc and LocalAlloc are implemented as wrapper functions that
-        // call HeapAlloc using a handle to the process's default heap. Therefore, GlobalAlloc and LocalAlloc
-        // have greater overhead than HeapAlloc.
-        hDIB             = GlobalAlloc(GHND, dwBmpSize);
-        data.bits        = (char*)GlobalLock(hDIB);
-        data.bitPerPixel = bitmap.bmBitsPixel;
-        data.height      = bitmap.bmHeight;
-        data.width       = bitmap.bmWidth;
-
-        // Gets the "bits" from the bitmap, and copies them into a buffer
-        // that's pointed to by lpbitmap.
-        GetDIBits(hScreen, hBitmap, 0, (UINT)bitmap.bmHeight, data.bits, (BITMAPINFO*)&bi, DIB_RGB_COLORS);
-    }
+    ScreenShoot(const ScreenShoot&)            = delete;
+    ScreenShoot& operator=(const ScreenShoot&) = delete;
 
     ~ScreenShoot()
     {
-        // Unlock and Free the DIB from the heap.
-        GlobalUnlock(hDIB);
-        GlobalFree(hDIB);
+        releaseBitmap();
+        if (hDC != nullptr)
+            DeleteDC(hDC);
+    }
 
-        // clean up
-        SelectObject(hDC, old_obj);
-        DeleteDC(hDC);
+    // Data is valid until the next capture
+    const Data& capture(int x, int y, int w, int h)
+    {
+        PROFILE_SCOPE("Screen capture");
+        FrameStageTimer stageTimer(EFrameStage::Capture);
+
+        data = Data{};
+        if (w * h == 0)
+            return data;
+
+        FrameStats::instance().addCaptureBytes(static_cast<uint64_t>(w) * h * 4);
+
+        // https://docs.microsoft.com/fr-fr/windows/win32/gdi/capturing-an-image
+        HDC hScreen = GetDC(NULL);
+        if (reserve(hScreen, w, h))
+        {
+            // Bottom left corner of the DIB, so that the rows of the capture are the first ones in memory
+            if (!BitBlt(hDC, 0, bitmapHeight - h, w, h, hScreen, x, y, SRCCOPY))
+            {
+                puts("BitBlt has failed");
+            }
+            GdiFlush(); // GDI batch need to be done before reading the bits
+
+            data.bits        = bitmapBits;
+            data.bitPerPixel = 32;
+            data.width       = w;
+            data.height      = h;
+            data.rowLength   = bitmapWidth;
+        }
         ReleaseDC(NULL, hScreen);
-        DeleteObject(hBitmap);
+        return data;
     }
 
-    const Data& get() // void* for static polymorphisme
+    const Data& get() const
     {
         return data;
     }
 };
 #else
-#endif
\ No newline at end of file
+#include <vector>
+
+// No screen capture on this platform yet (ex: headless benchmark on Linux): the capture is black, so only the
+// monitors borders collide. It still goes through the whole collision path.
+class ScreenShoot
+{
+public:
+    struct Data
+    {
+        unsigned int width       = 0;
+        unsigned int height      = 0;
+        unsigned int bitPerPixel = 0;
+        unsigned int rowLength   = 0; // In pixels
+        void*        bits        = nullptr;
+    };
+
+protected:
+    std::vector<unsigned char> bits; // Zero filled, only grows
+    Data                       data;
+
+public:
+    // Data is valid until the next capture
+    const Data& capture(int x, int y, int w, int h)
+    {
+        PROFILE_SCOPE("Screen capture");
+        FrameStageTimer stageTimer(EFrameStage::Capture);
+
+        data = Data{};
+        if (w <= 0 || h <= 0)
+            return data;
+
+        FrameStats::instance().addCaptureBytes(static_cast<uint64_t>(w) * h * 4);
+
+        const size_t size = static_cast<size_t>(w) * h * 4;
+        if (bits.size() < size)
+            bits.resize(size);
+
+        data.bits        = bits.data();
+        data.bitPerPixel = 32;
+        data.width       = w;
+        data.height      = h;
+        data.rowLength   = w;
+        return data;
+    }
+
+    const Data& get() const
+    {
+        return data;
+    }
+};
+#endif
@@ -3,10 +3,26 @@
 #include "Engine/Singleton.hpp"
 #include "Game/GameData.hpp"
 
+namespace YAML
+{
+class Emitter;
+class Node;
+} // namespace YAML
+
 class Setting : public Singleton<Setting>
 {
+protected:
+    // Root is the sequence of sections
+    void importNode(const YAML::Node& root, GameData& data);
+
+    void emit(YAML::Emitter& out, GameData& data);
+
 public:
     void importFile(const char* src, GameData& data);
 
+    // Values is a map of sections with the values to change (ex: {Physic: {Bounciness: 0.5}}). Others keep their
+    // current value.
+    void importValues(const YAML::Node& values, GameData& data);
+
     void exportFile(const char* dest, GameData& data);
 };
\ No newline at end of file
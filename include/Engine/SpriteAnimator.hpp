@@ -58,10 +58,20 @@ public:
         }
     }
 
-    void draw(const Rect& rect, GameData& datas, Shader& shader, bool donthFlip)
+    void draw(const Rect& rect, SpriteRenderer& renderer, bool donthFlip)
     {
         if (pSheet != nullptr)
-            pSheet->useSection(rect, datas, shader, indexCurrentAnimSprite, !donthFlip);
+            pSheet->drawSection(rect, renderer, indexCurrentAnimSprite, !donthFlip);
+    }
+
+    // Time before the displayed sprite change. Done animation need to be updated as soon as possible to let the end
+    // transitions be evaluated
+    float getTimeBeforeNextFrame() const
+    {
+        if (isDone())
+            return 0.f;
+
+        return (indexCurrentAnimSprite + 1) / (float)frameRate - timer;
     }
 
     bool isDone() const
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "Engine/Canvas.hpp"
+#include "Engine/Rect.hpp"
+
+class Texture;
+
+// Draw the sprites of a frame in the window back buffer. OpenGL draws each sprite with the sprite sheet shader, the
+// software renderer blends them on the CPU and present the result once per frame.
+class SpriteRenderer
+{
+public:
+    virtual ~SpriteRenderer() = default;
+
+    // Region of the window cleared by Window::initDrawContext, sprites outside of it are skipped
+    virtual void beginFrame(const Canvas::DamageRegion& damage) = 0;
+
+    // Horizontal section [uOffset, uOffset + uScale] of the texture drawn in rect, in screen coordinates. Negative
+    // scale flips the section.
+    virtual void drawSprite(const Texture& texture, const Rect& rect, float uOffset = 0.f, float uScale = 1.f) = 0;
+
+    // Sprites are in the back buffer after this call, before the UI
+    virtual void endFrame() = 0;
+};
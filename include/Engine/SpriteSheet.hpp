@@ -1,14 +1,13 @@
 #pragma once
 
 #ifdef USE_OPENGL_API
-#include "Engine/Graphics/ShaderOGL.hpp"
 #include "Engine/Graphics/TextureOGL.hpp"
 #endif // USE_OPENGL_API
 
 #include "Engine/ClassUtility.hpp"
 #include "Engine/Vector2.hpp"
 #include "Engine/Rect.hpp"
-#include "Game/GameData.hpp"
+#include "Engine/SpriteRenderer.hpp"
 
 class SpriteSheet : public Texture
 {
@@ -25,20 +24,10 @@ public:
     GETTER_BY_VALUE(TileCount, tileCount)
     GETTER_BY_VALUE(SizeFactor, sizeFactor)
 
-    void useSection(const Rect& rect, GameData& data, Shader& shader, int idSection, bool hFlip = false)
+    void drawSection(const Rect& rect, SpriteRenderer& renderer, int idSection, bool hFlip = false)
     {
-        float       hScale  = 1.f / tileCount;
-        const float vScale  = 1.f; // This field can be used
-        float       hOffSet = idSection / (float)tileCount;
-        const float vOffset = 0.f; // This field can be used
-
-        Vec2 clipSpacePos = Vec2::remap(rect.getCornerMin(), data.window->getCornerMin(),
-                        data.window->getCornerMax(), Vec2{0, 1}, Vec2{1, 0}); // [-1, 1]
-        Vec2 clipSpaceSize =
-            Vec2::remap(rect.getSize(), Vec2{0, 0}, data.window->getSize(), Vec2{0, 0}, Vec2{1, 1}); // [0, 1]
-
-        // In shader, based on bottom left instead of upper left
-        clipSpacePos.y -= clipSpaceSize.y;
+        float hScale  = 1.f / tileCount;
+        float hOffSet = idSection / (float)tileCount;
 
         if (hFlip)
         {
@@ -46,9 +35,6 @@ public:
             hScale *= -1;
         }
 
-        shader.use();
-        shader.setVec4("uScaleOffSet", hScale, vScale, hOffSet, vOffset);
-        shader.setVec4("uClipSpacePosSize", clipSpacePos.x, clipSpacePos.y, clipSpaceSize.x, clipSpaceSize.y);
-        use();
+        renderer.drawSprite(*this, rect, hOffSet, hScale);
     }
 };
\ No newline at end of file
@@ -0,0 +1,9 @@
+#pragma once
+
+#include <cstddef>
+
+// Return the CPU time (user + kernel) consumed by the process in seconds
+double getProcessCPUTime();
+
+// Return the resident memory of the process (working set on Windows) in bytes, 0 if unknown
+size_t getProcessResidentMemory();
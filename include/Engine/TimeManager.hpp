@@ -1,37 +1,24 @@
 #pragma once
 
+#include "Engine/ClassUtility.hpp"
+#include "Engine/Profiler.hpp"
 #include "Engine/Singleton.hpp"
+#include "Engine/SystemInfo.hpp"
+#include "Engine/TimingWheel.hpp"
 #include "Game/GameData.hpp"
 
 #include <GLFW/glfw3.h>
 
 #include <functional>
-#include <queue>
-#include <vector>
 #include <cmath>
-
-struct TimerTask
-{
-    std::function<void()> task        = nullptr;
-    double                localTimer  = 0.; // if current time egal 1s and local timer egal 0.5 global time egal 1.5
-    double                globalTimer = 0.;
-    bool                  isLooping   = false;
-
-    TimerTask(const std::function<void()>& task = nullptr, double localTimer = .0, double globalTimer = .0,
-              bool isLooping = false)
-        : task{task}, localTimer{localTimer}, globalTimer{globalTimer}, isLooping{isLooping}
-    {
-    }
-
-    bool operator>(const TimerTask& other) const noexcept
-    {
-        return globalTimer > other.globalTimer;
-    }
-};
+#include <algorithm>
 
 class TimeManager : public Singleton<TimeManager>
 {
 protected:
+    // Longer frame are clamped. Also used as maximum sleep duration to keep the clamp unnoticeable
+    static constexpr double s_maxDeltaTime = 0.25;
+
     double m_time     = glfwGetTime();
     double m_tempTime = m_time;
 
@@ -40,9 +27,68 @@ protected:
     double    m_fixedDeltaTime = 1. / 60.;
     GameData* datas;
 
-    std::priority_queue<TimerTask, std::vector<TimerTask>, std::greater<TimerTask>> m_timerQueue;
+    // Limited update can be delayed more than the frame rate if nothing need it (ex: next sprite animation frame)
+    double m_limitedUpdateDelay       = 0.;
+    bool   m_isLimitedUpdateRequested = false;
+
+    // Statistics
+    int    m_wakeUpCount      = 0;
+    double m_statisticTimer   = 0.;
+    double m_statisticCPUTime = getProcessCPUTime();
+    float  m_wakeUpsPerSecond = 0.f;
+    float  m_CPUUsage         = 0.f; // In percent of one core
+    double m_droppedTime      = 0.;  // Not simulated because of the delta time clamp, since the start
+
+    // Input to present latency, from the first cursor event not yet visible to the swap of the frame showing it
+    double m_unappliedInputTime = -1.;
+    double m_pendingInputTime   = -1.;
+    double m_inputLatencySum    = 0.;
+    double m_inputLatencyMaxAcc = 0.;
+    int    m_inputLatencyCount  = 0;
+    float  m_inputLatency_ms    = 0.f;
+    float  m_maxInputLatency_ms = 0.f;
+
+    TimingWheel m_timingWheel;
+
+protected:
+    double getLimitedUpdateDelay() const noexcept
+    {
+        return m_isLimitedUpdateRequested ? 0. : std::max(m_fixedDeltaTime, m_limitedUpdateDelay);
+    }
+
+    void updateStatistics()
+    {
+        ++m_wakeUpCount;
+        m_statisticTimer += m_deltaTime;
+
+        if (m_statisticTimer >= 1.)
+        {
+            const double CPUTime = getProcessCPUTime();
+            m_wakeUpsPerSecond   = static_cast<float>(m_wakeUpCount / m_statisticTimer);
+            m_CPUUsage           = static_cast<float>((CPUTime - m_statisticCPUTime) / m_statisticTimer * 100.);
+            m_statisticCPUTime   = CPUTime;
+            m_statisticTimer     = 0.;
+            m_wakeUpCount        = 0;
+
+            // Keep the last measure while nothing is dragged
+            if (m_inputLatencyCount != 0)
+            {
+                m_inputLatency_ms    = static_cast<float>(m_inputLatencySum / m_inputLatencyCount * 1000.);
+                m_maxInputLatency_ms = static_cast<float>(m_inputLatencyMaxAcc * 1000.);
+                m_inputLatencySum    = 0.;
+                m_inputLatencyMaxAcc = 0.;
+                m_inputLatencyCount  = 0;
+            }
+        }
+    }
 
 public:
+    GETTER_BY_VALUE(WakeUpsPerSecond, m_wakeUpsPerSecond)
+    GETTER_BY_VALUE(CPUUsage, m_CPUUsage)
+    GETTER_BY_VALUE(DroppedTime, m_droppedTime)
+    GETTER_BY_VALUE(InputLatency_ms, m_inputLatency_ms)
+    GETTER_BY_VALUE(MaxInputLatency_ms, m_maxInputLatency_ms)
+
     void Init(GameData& data)
     {
         m_fixedDeltaTime = 1. / data.FPS;
@@ -56,9 +102,10 @@ public:
         m_tempTime = m_time;
     }
 
-    inline void emplaceTimer(std::function<void()> functionToExecute, double delay, bool isLooping = false) noexcept
+    // The timer is cancelled when the returned handle is destroyed
+    [[nodiscard]] TimerHandle emplaceTimer(TimerCallback functionToExecute, double delay, bool isLooping = false)
     {
-        m_timerQueue.emplace(functionToExecute, delay, delay + datas->timeAcc, isLooping);
+        return {m_timingWheel, m_timingWheel.schedule(std::move(functionToExecute), delay, isLooping)};
     }
 
     void setFrameRate(int FPS)
@@ -66,9 +113,63 @@ public:
         m_fixedDeltaTime = 1. / FPS;
     }
 
-    void update(std::function<void(double deltaTime)> unlimitedUpdateFunction,
-                std::function<void(double deltaTime)> limitedUpdateFunction)
+    // Minimal delay between two limited updates. Frame rate stay the upper bound
+    void setLimitedUpdateDelay(double delay) noexcept
+    {
+        m_limitedUpdateDelay = delay;
+    }
+
+    // Run the limited update during the next update regardless of the frame rate (ex: input event)
+    void requestLimitedUpdate() noexcept
+    {
+        m_isLimitedUpdateRequested = true;
+    }
+
+    // Input that will move something on screen once applied
+    void markInput() noexcept
+    {
+        if (m_unappliedInputTime < 0.)
+            m_unappliedInputTime = glfwGetTime();
+    }
+
+    // The input is visible in the next frame
+    void markInputApplied() noexcept
+    {
+        if (m_pendingInputTime < 0.)
+            m_pendingInputTime = m_unappliedInputTime;
+        m_unappliedInputTime = -1.;
+    }
+
+    void markFramePresented() noexcept
+    {
+        if (m_pendingInputTime < 0.)
+            return;
+
+        const double latency = glfwGetTime() - m_pendingInputTime;
+        m_inputLatencySum += latency;
+        m_inputLatencyMaxAcc = std::max(m_inputLatencyMaxAcc, latency);
+        ++m_inputLatencyCount;
+        m_pendingInputTime = -1.;
+    }
+
+    // Time that the main loop can sleep before the next limited update or timer
+    double getTimeBeforeNextDeadline() const
+    {
+        double deadline = getLimitedUpdateDelay() - m_timeAccLoop;
+
+        deadline = std::min(deadline, m_timingWheel.getTimeBeforeNextExpiry(s_maxDeltaTime));
+
+        // Remove the time elapsed since the last update
+        deadline -= glfwGetTime() - m_time;
+        return std::clamp(deadline, 0., s_maxDeltaTime);
+    }
+
+    // Callables taking the delta time in seconds. Not std::function so that nothing is copied or allocated per frame.
+    template <typename UnlimitedUpdateFunction, typename LimitedUpdateFunction>
+    void update(UnlimitedUpdateFunction&& unlimitedUpdateFunction, LimitedUpdateFunction&& limitedUpdateFunction)
     {
+        PROFILE_SCOPE("TimeManager::update");
+
         /*unfixed update*/
         unlimitedUpdateFunction(m_deltaTime);
 
@@ -78,8 +179,13 @@ public:
         m_time      = m_tempTime;
 
         // This is temporary
-        if (m_deltaTime > 0.25)
-            m_deltaTime = 0.25;
+        if (m_deltaTime > s_maxDeltaTime)
+        {
+            m_droppedTime += m_deltaTime - s_maxDeltaTime;
+            m_deltaTime = s_maxDeltaTime;
+        }
+
+        updateStatistics();
 
         /*Add accumulator*/
         datas->timeAcc += m_deltaTime;
@@ -88,30 +194,17 @@ public:
         /*Fixed update*/
         m_timeAccLoop += m_deltaTime;
 
-        if (m_timeAccLoop >= m_fixedDeltaTime)
+        if (m_timeAccLoop >= getLimitedUpdateDelay())
         {
+            PROFILE_SCOPE("Limited update");
             limitedUpdateFunction(m_timeAccLoop);
-            m_timeAccLoop = 0.f;
+            m_timeAccLoop              = 0.f;
+            m_isLimitedUpdateRequested = false;
         }
 
-        while (!m_timerQueue.empty() && m_timerQueue.top().globalTimer <= datas->timeAcc)
-        {
-            const TimerTask& timerTask = m_timerQueue.top();
-            timerTask.task();
+        m_timingWheel.advance(m_deltaTime);
 
-            if (timerTask.isLooping)
-            {
-                emplaceTimer(timerTask.task, timerTask.localTimer, timerTask.isLooping);
-            }
-            m_timerQueue.pop();
-        }
-
-        while (!datas->deltasCursorPosBuffer.empty() &&
-               datas->deltasCursorPosBuffer.top().timer + datas->coyoteTimeCursorPos <= datas->timeAcc)
-        {
-            const GameData::DeltaCursosPosElem& elem = datas->deltasCursorPosBuffer.top();
-            datas->deltaCursorAcc -= elem.pos;
-            datas->deltasCursorPosBuffer.pop();
-        }
+        // Only the samples of the coyote time are used by the release velocity
+        datas->cursorTracker.removeSamplesBefore(m_time - datas->coyoteTimeCursorPos);
     }
 };
\ No newline at end of file
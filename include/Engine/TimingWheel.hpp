@@ -0,0 +1,381 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Move only callable without allocation for small captures (ex: lambda capturing a few pointers)
+class TimerCallback
+{
+public:
+    static constexpr size_t s_bufferSize = 48;
+
+protected:
+    struct VTable
+    {
+        void (*invoke)(void* buffer);
+        void (*move)(void* dst, void* src); // Destroy src
+        void (*destroy)(void* buffer);
+    };
+
+    template <typename TFunc>
+    static constexpr bool s_isStoredInBuffer = sizeof(TFunc) <= s_bufferSize &&
+                                               alignof(TFunc) <= alignof(std::max_align_t) &&
+                                               std::is_nothrow_move_constructible_v<TFunc>;
+
+    alignas(std::max_align_t) unsigned char m_buffer[s_bufferSize];
+    const VTable* m_vtable = nullptr;
+
+protected:
+    template <typename TFunc>
+    static const VTable* getVTable()
+    {
+        if constexpr (s_isStoredInBuffer<TFunc>)
+        {
+            static constexpr VTable vtable{[](void* buffer) { (*static_cast<TFunc*>(buffer))(); },
+                                           [](void* dst, void* src) {
+                                               new (dst) TFunc(std::move(*static_cast<TFunc*>(src)));
+                                               static_cast<TFunc*>(src)->~TFunc();
+                                           },
+                                           [](void* buffer) { static_cast<TFunc*>(buffer)->~TFunc(); }};
+            return &vtable;
+        }
+        else
+        {
+            // Buffer only store the pointer
+            static constexpr VTable vtable{[](void* buffer) { (**static_cast<TFunc**>(buffer))(); },
+                                           [](void* dst, void* src) {
+                                               *static_cast<TFunc**>(dst) = *static_cast<TFunc**>(src);
+                                           },
+                                           [](void* buffer) { delete *static_cast<TFunc**>(buffer); }};
+            return &vtable;
+        }
+    }
+
+public:
+    TimerCallback() noexcept = default;
+
+    template <typename TFunc, typename = std::enable_if_t<!std::is_same_v<std::decay_t<TFunc>, TimerCallback>>>
+    TimerCallback(TFunc&& func)
+    {
+        using TStored = std::decay_t<TFunc>;
+        if constexpr (s_isStoredInBuffer<TStored>)
+            new (m_buffer) TStored(std::forward<TFunc>(func));
+        else
+            *reinterpret_cast<TStored**>(m_buffer) = new TStored(std::forward<TFunc>(func));
+
+        m_vtable = getVTable<TStored>();
+    }
+
+    TimerCallback(TimerCallback&& other) noexcept : m_vtable{other.m_vtable}
+    {
+        if (m_vtable != nullptr)
+            m_vtable->move(m_buffer, other.m_buffer);
+        other.m_vtable = nullptr;
+    }
+
+    TimerCallback& operator=(TimerCallback&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            m_vtable = other.m_vtable;
+            if (m_vtable != nullptr)
+                m_vtable->move(m_buffer, other.m_buffer);
+            other.m_vtable = nullptr;
+        }
+        return *this;
+    }
+
+    TimerCallback(const TimerCallback&)            = delete;
+    TimerCallback& operator=(const TimerCallback&) = delete;
+
+    ~TimerCallback()
+    {
+        reset();
+    }
+
+    void reset() noexcept
+    {
+        if (m_vtable != nullptr)
+            m_vtable->destroy(m_buffer);
+        m_vtable = nullptr;
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return m_vtable != nullptr;
+    }
+
+    void operator()()
+    {
+        m_vtable->invoke(m_buffer);
+    }
+};
+
+// Hashed timing wheel: timers are linked in the slot of their expiration tick, insert and cancel are O(1) and an
+// update only visits the slots of the elapsed ticks. Timers further than one lap stay in their slot until their tick.
+class TimingWheel
+{
+public:
+    static constexpr double   s_tickDuration = 0.001; // In seconds
+    static constexpr uint32_t s_slotCount    = 1024;  // Power of two, one lap is about one second
+    static constexpr uint32_t s_invalidIndex = UINT32_MAX;
+
+    struct TimerId
+    {
+        uint32_t index      = s_invalidIndex;
+        uint32_t generation = 0;
+    };
+
+protected:
+    enum class ETimerState : uint8_t
+    {
+        Free,
+        Scheduled,
+        Firing,
+        Cancelled // While firing
+    };
+
+    struct Timer
+    {
+        TimerCallback callback;
+        uint64_t      expiryTick  = 0;
+        double        expiry      = 0.; // In ticks, keep the fraction so that looping timers don't drift
+        double        period      = 0.; // In ticks, 0 if not looping
+        uint32_t      previous    = s_invalidIndex;
+        uint32_t      next        = s_invalidIndex;
+        uint32_t      generation  = 0;
+        ETimerState   state       = ETimerState::Free;
+    };
+
+    std::vector<Timer>    m_timers;
+    std::vector<uint32_t> m_freeTimers;
+    std::vector<uint32_t> m_firingTimers; // Reused by each tick
+    uint32_t              m_slots[s_slotCount];
+    uint64_t              m_currentTick = 0;
+    double                m_tickTimeAcc = 0.;
+
+protected:
+    void setExpiry(Timer& timer, double expiry) noexcept
+    {
+        timer.expiry     = expiry;
+        timer.expiryTick = std::max(static_cast<uint64_t>(std::ceil(expiry)), m_currentTick + 1);
+    }
+
+    void link(uint32_t index) noexcept
+    {
+        Timer&    timer = m_timers[index];
+        uint32_t& head  = m_slots[timer.expiryTick & (s_slotCount - 1)];
+        timer.previous  = s_invalidIndex;
+        timer.next      = head;
+        if (head != s_invalidIndex)
+            m_timers[head].previous = index;
+        head = index;
+    }
+
+    void unlink(uint32_t index) noexcept
+    {
+        Timer& timer = m_timers[index];
+        if (timer.previous != s_invalidIndex)
+            m_timers[timer.previous].next = timer.next;
+        else
+            m_slots[timer.expiryTick & (s_slotCount - 1)] = timer.next;
+
+        if (timer.next != s_invalidIndex)
+            m_timers[timer.next].previous = timer.previous;
+    }
+
+    void release(uint32_t index)
+    {
+        Timer& timer = m_timers[index];
+        timer.callback.reset();
+        timer.state = ETimerState::Free;
+        ++timer.generation;
+        m_freeTimers.emplace_back(index);
+    }
+
+    void processTick()
+    {
+        // Collect before calling, callbacks can schedule and cancel timers
+        uint32_t index = m_slots[m_currentTick & (s_slotCount - 1)];
+        while (index != s_invalidIndex)
+        {
+            Timer&         timer = m_timers[index];
+            const uint32_t next  = timer.next;
+            if (timer.expiryTick <= m_currentTick)
+            {
+                unlink(index);
+                timer.state = ETimerState::Firing;
+                m_firingTimers.emplace_back(index);
+            }
+            index = next;
+        }
+
+        for (const uint32_t firingIndex : m_firingTimers)
+        {
+            if (m_timers[firingIndex].state == ETimerState::Cancelled)
+            {
+                release(firingIndex);
+                continue;
+            }
+
+            // Timers can be reallocated by the callback
+            TimerCallback callback = std::move(m_timers[firingIndex].callback);
+            callback();
+
+            Timer& timer = m_timers[firingIndex];
+            if (timer.state == ETimerState::Firing && timer.period != 0.)
+            {
+                timer.callback = std::move(callback);
+                timer.state    = ETimerState::Scheduled;
+                setExpiry(timer, timer.expiry + timer.period);
+                link(firingIndex);
+            }
+            else
+            {
+                release(firingIndex);
+            }
+        }
+        m_firingTimers.clear();
+    }
+
+public:
+    TimingWheel()
+    {
+        std::fill(std::begin(m_slots), std::end(m_slots), s_invalidIndex);
+    }
+
+    TimerId schedule(TimerCallback&& callback, double delay, bool isLooping)
+    {
+        uint32_t index;
+        if (m_freeTimers.empty())
+        {
+            index = static_cast<uint32_t>(m_timers.size());
+            m_timers.emplace_back();
+        }
+        else
+        {
+            index = m_freeTimers.back();
+            m_freeTimers.pop_back();
+        }
+
+        const double delayTicks = std::max(delay / s_tickDuration, 1.);
+        Timer&       timer      = m_timers[index];
+        timer.callback          = std::move(callback);
+        timer.period            = isLooping ? delayTicks : 0.;
+        timer.state             = ETimerState::Scheduled;
+        setExpiry(timer, static_cast<double>(m_currentTick) + delayTicks);
+        link(index);
+
+        return {index, timer.generation};
+    }
+
+    void cancel(TimerId id)
+    {
+        if (!isActive(id))
+            return;
+
+        Timer& timer = m_timers[id.index];
+        if (timer.state == ETimerState::Firing)
+        {
+            timer.state = ETimerState::Cancelled;
+        }
+        else
+        {
+            unlink(id.index);
+            release(id.index);
+        }
+    }
+
+    bool isActive(TimerId id) const noexcept
+    {
+        return id.index < m_timers.size() && m_timers[id.index].generation == id.generation &&
+               (m_timers[id.index].state == ETimerState::Scheduled || m_timers[id.index].state == ETimerState::Firing);
+    }
+
+    void advance(double deltaTime)
+    {
+        m_tickTimeAcc += deltaTime;
+        const uint64_t tickCount = static_cast<uint64_t>(m_tickTimeAcc / s_tickDuration);
+        m_tickTimeAcc -= tickCount * s_tickDuration;
+
+        for (uint64_t i = 0; i < tickCount; ++i)
+        {
+            ++m_currentTick;
+            processTick();
+        }
+    }
+
+    // Only look for the next maxDuration seconds, return maxDuration if no timer expire before
+    double getTimeBeforeNextExpiry(double maxDuration) const noexcept
+    {
+        const uint64_t tickCount = std::min<uint64_t>(static_cast<uint64_t>(std::ceil(maxDuration / s_tickDuration)),
+                                                      s_slotCount);
+        for (uint64_t tick = m_currentTick + 1; tick <= m_currentTick + tickCount; ++tick)
+        {
+            for (uint32_t index = m_slots[tick & (s_slotCount - 1)]; index != s_invalidIndex;
+                 index          = m_timers[index].next)
+            {
+                if (m_timers[index].expiryTick == tick)
+                    return (tick - m_currentTick) * s_tickDuration - m_tickTimeAcc;
+            }
+        }
+        return maxDuration;
+    }
+};
+
+// Cancel the timer when destroyed, a timer owner can't be called after its destruction
+class TimerHandle
+{
+protected:
+    TimingWheel*         m_wheel = nullptr;
+    TimingWheel::TimerId m_id;
+
+public:
+    TimerHandle() noexcept = default;
+
+    TimerHandle(TimingWheel& wheel, TimingWheel::TimerId id) noexcept : m_wheel{&wheel}, m_id{id}
+    {
+    }
+
+    TimerHandle(TimerHandle&& other) noexcept : m_wheel{std::exchange(other.m_wheel, nullptr)}, m_id{other.m_id}
+    {
+    }
+
+    TimerHandle& operator=(TimerHandle&& other) noexcept
+    {
+        if (this != &other)
+        {
+            cancel();
+            m_wheel = std::exchange(other.m_wheel, nullptr);
+            m_id    = other.m_id;
+        }
+        return *this;
+    }
+
+    TimerHandle(const TimerHandle&)            = delete;
+    TimerHandle& operator=(const TimerHandle&) = delete;
+
+    ~TimerHandle()
+    {
+        cancel();
+    }
+
+    void cancel()
+    {
+        if (m_wheel != nullptr)
+            m_wheel->cancel(m_id);
+        m_wheel = nullptr;
+    }
+
+    bool isActive() const noexcept
+    {
+        return m_wheel != nullptr && m_wheel->isActive(m_id);
+    }
+};
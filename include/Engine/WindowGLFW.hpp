@@ -17,9 +17,19 @@ protected:
 
     bool isMousePassThrough;
     bool useMousePassThrough;
+    bool useFitToElements = false;
+
+    // Compact window size is rounded to limit swap chain reallocations when sprite size changes
+    static constexpr float s_compactSizeGranularity = 32.f;
+    // Room around the elements so that moving pets don't move the window, and so fully redraw it, each frame
+    static constexpr float s_compactMargin = 64.f;
+    // Window is refitted once its area is this times the area needed by the elements
+    static constexpr float s_compactOversizeRatio = 4.f;
+    // Part of the primary monitor above which the window covers the whole monitor instead of following the elements
+    static constexpr float s_compactMonitorCoverage = 0.5f;
 
 protected:
-    void initGLFW();
+    void initGLFW(bool headless);
     void preSetupWindow(const struct GameData& datas);
     void postSetupWindow(struct GameData& datas);
     void initWindow(struct GameData& datas);
@@ -35,6 +45,7 @@ protected:
 
 public:
     GETTER_BY_VALUE(Window, window)
+    GETTER_BY_VALUE(UseFitToElements, useFitToElements)
 
     void setMousePassThrough(bool flag)
     {
@@ -65,7 +76,66 @@ public:
     void setPositionSize(const Vec2 windowPos, const Vec2 windowSize) noexcept
     {
         setPosition(windowPos);
-        setSize(windowPos);
+        setSize(windowSize);
+    }
+
+    // Compact mode: move and resize the window to the area covered by its elements instead of the whole desktop.
+    // The window is a single rectangle: spread pets make it as large as the area between them. Once the elements
+    // cover most of the primary monitor, the window covers the whole monitor and only the damaged regions are redrawn.
+    void fitToElements()
+    {
+        if (!useFitToElements || m_elements.empty())
+            return;
+
+        Vec2 cornerMin = m_elements.front()->getCornerMin();
+        Vec2 cornerMax = m_elements.front()->getCornerMax();
+        for (const Rect* element : m_elements)
+        {
+            cornerMin.x = std::min(cornerMin.x, element->getCornerMin().x);
+            cornerMin.y = std::min(cornerMin.y, element->getCornerMin().y);
+            cornerMax.x = std::max(cornerMax.x, element->getCornerMax().x);
+            cornerMax.y = std::max(cornerMax.y, element->getCornerMax().y);
+        }
+
+        // Moving or resizing the window forces a full redraw: keep it while it contains the elements
+        const Vec2 windowMax   = m_position + m_size;
+        const Vec2 neededSize  = cornerMax - cornerMin + Vec2{s_compactMargin, s_compactMargin} * 2.f;
+        const bool isInside    = cornerMin.x >= m_position.x && cornerMin.y >= m_position.y &&
+                                 cornerMax.x <= windowMax.x && cornerMax.y <= windowMax.y;
+        const bool isOversized = m_size.x * m_size.y > s_compactOversizeRatio * neededSize.x * neededSize.y;
+        if (isInside && !isOversized)
+            return;
+
+        Vec2 position{std::floor(cornerMin.x - s_compactMargin), std::floor(cornerMin.y - s_compactMargin)};
+        Vec2 size{std::ceil(neededSize.x / s_compactSizeGranularity) * s_compactSizeGranularity,
+                  std::ceil(neededSize.y / s_compactSizeGranularity) * s_compactSizeGranularity};
+
+        // Without monitor (headless), the window always follows the elements
+        if (GLFWmonitor* monitor = glfwGetPrimaryMonitor())
+        {
+            int monitorX, monitorY, monitorWidth, monitorHeight;
+            glfwGetMonitorWorkarea(monitor, &monitorX, &monitorY, &monitorWidth, &monitorHeight);
+            if (size.x * size.y > s_compactMonitorCoverage * monitorWidth * monitorHeight)
+            {
+                const Vec2 fittedMax = position + size;
+                position.x           = std::min(position.x, static_cast<float>(monitorX));
+                position.y           = std::min(position.y, static_cast<float>(monitorY));
+                size.x               = std::max(fittedMax.x, static_cast<float>(monitorX + monitorWidth)) - position.x;
+                size.y               = std::max(fittedMax.y, static_cast<float>(monitorY + monitorHeight)) - position.y;
+            }
+        }
+
+        if (!(size == m_size))
+        {
+            m_size = size;
+            glfwSetWindowSize(window, static_cast<int>(m_size.x), static_cast<int>(m_size.y));
+        }
+
+        if (!(position == m_position))
+        {
+            m_position = position;
+            glfwSetWindowPos(window, static_cast<int>(m_position.x), static_cast<int>(m_position.y));
+        }
     }
 
     inline bool shouldClose() const noexcept
@@ -91,12 +161,16 @@ public:
     void addElement(Rect& element)
     {
         m_elements.emplace_back(&element);
-        element.setOnChange([&](const Rect& other) 
-            { UpdatePositionSize(other); });
+        element.setOnChange([&](const Rect& other) {
+            // Compact window is fitted once per frame
+            if (!useFitToElements)
+                UpdatePositionSize(other);
+        });
     }
 
     void removeElement(Rect& element)
     {
+        addDamage(element);
         m_elements.remove_if([&](auto rect) { return rect == &element; });
     }
 };
\ No newline at end of file
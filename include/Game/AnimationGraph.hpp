@@ -0,0 +1,145 @@
+#pragma once
+
+#include "Engine/SpriteSheet.hpp"
+#include "Engine/TimingWheel.hpp"
+#include "Engine/Vector2.hpp"
+#include "Game/GameData.hpp"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "yaml-cpp/yaml.h"
+
+// Per pet state of the animation graph
+struct AnimationState
+{
+    // Transitions of the current node are only evaluated if one of the events they depend on is pending
+    enum EEvent : uint8_t
+    {
+        Enter                  = 1 << 0,
+        LeftPress              = 1 << 1,
+        LeftRelease            = 1 << 2,
+        GroundedChanged        = 1 << 3,
+        TouchScreenEdgeChanged = 1 << 4,
+        AnimationEnd           = 1 << 5,
+        Deadline               = 1 << 6
+    };
+
+    uint16_t    node                  = 0;
+    uint16_t    randomDelayTransition = UINT16_MAX; // Random delay transition that fire first in the current node
+    TimerHandle randomDelayTimer;                   // Raise the deadline event
+    uint8_t     direction             = 0;          // Index in the node directions
+    uint8_t     pendingEvents         = 0;
+};
+
+// Animation state machine compiled once from animation.yaml and shared by all the pets. Nodes, transitions and
+// targets are flat immutable tables and all the pets are stepped in one pass.
+class AnimationGraph
+{
+public:
+    static constexpr uint16_t s_invalidIndex = UINT16_MAX;
+
+    enum class ENodeType : uint8_t
+    {
+        Animation,
+        Grab,
+        MovementDirection,
+        PetJump
+    };
+
+    enum class ECondition : uint8_t
+    {
+        StartLeftClic,
+        EndLeftClic,
+        TouchScreenEdge,
+        IsGrounded,
+        IsNotGrounded,
+        RandomDelay,
+        AnimationEnd
+    };
+
+    struct Node
+    {
+        ENodeType type             = ENodeType::Animation;
+        bool      loop             = true;
+        bool      applyGravity     = true; // MovementDirection only
+        uint16_t  spriteSheet      = 0;
+        int       frameRate        = 1;
+        uint16_t  firstTransition  = 0;
+        uint16_t  transitionCount  = 0;
+        uint8_t   eventMask        = 0; // Events used by the node transitions
+        uint16_t  firstDirection   = 0; // MovementDirection and PetJump
+        uint16_t  directionCount   = 0;
+        float     verticalThrust   = 0.f; // PetJump only
+        float     horizontalThrust = 0.f; // PetJump only
+    };
+
+    struct Transition
+    {
+        ECondition condition    = ECondition::AnimationEnd;
+        uint16_t   firstTarget  = 0;
+        uint16_t   targetCount  = 0;
+        int        baseDelay_ms = 0; // RandomDelay only
+        int        interval_ms  = 0; // RandomDelay only
+    };
+
+protected:
+    std::vector<Node>                         m_nodes;
+    std::vector<Transition>                   m_transitions; // Grouped by node
+    std::vector<uint16_t>                     m_targets;
+    std::vector<Vec2>                         m_directions;
+    std::vector<std::unique_ptr<SpriteSheet>> m_spriteSheets;
+    uint16_t                                  m_firstNode = 0;
+    uint16_t                                  m_pauseNode = s_invalidIndex;
+
+protected:
+    static constexpr uint8_t getConditionEvents(ECondition condition)
+    {
+        switch (condition)
+        {
+        case ECondition::StartLeftClic:
+            return AnimationState::LeftPress;
+        case ECondition::EndLeftClic:
+            return AnimationState::Enter | AnimationState::LeftRelease;
+        case ECondition::TouchScreenEdge:
+            return AnimationState::Enter | AnimationState::TouchScreenEdgeChanged;
+        case ECondition::IsGrounded:
+        case ECondition::IsNotGrounded:
+            return AnimationState::Enter | AnimationState::GroundedChanged;
+        case ECondition::RandomDelay:
+            return AnimationState::Deadline;
+        case ECondition::AnimationEnd:
+            return AnimationState::AnimationEnd;
+        }
+        return 0;
+    }
+
+    uint16_t parseSpriteSheet(YAML::Node node, std::map<std::string, uint16_t>& spriteSheetsIndex);
+
+    bool parseNode(const std::string& type, YAML::Node node, std::map<std::string, uint16_t>& nodesIndex,
+                   std::map<std::string, uint16_t>& spriteSheetsIndex);
+
+    bool parseTransition(const std::string& type, YAML::Node node, const std::map<std::string, uint16_t>& nodesIndex,
+                         std::vector<std::vector<Transition>>& nodesTransitions);
+
+    void enterNode(class Pet& pet, uint16_t nodeIndex, GameData& datas) const;
+
+    void exitNode(class Pet& pet) const;
+
+    bool isConditionMet(const Transition& transition, uint16_t transitionIndex, class Pet& pet,
+                        GameData& datas) const;
+
+public:
+    AnimationGraph(const char* path);
+
+    // Enter in the first node
+    void start(class Pet& pet, GameData& datas) const;
+
+    // Paused pets stay in the pause node without evaluating transitions
+    void setPaused(class Pet& pet, bool isPaused, GameData& datas) const;
+
+    void update(const std::vector<std::shared_ptr<class Pet>>& pets, GameData& datas, double deltaTime) const;
+};
@@ -1,15 +1,19 @@
 #pragma once
 
 #include "Engine/Log.hpp"
+#include "Engine/TimeManager.hpp"
+#include "Engine/Utilities.hpp"
 #include "Engine/UtilitySystem.hpp"
 #include "Game/GameData.hpp"
 
 #ifdef USE_OPENGL_API
 #include "Engine/Graphics/ScreenSpaceQuadOGL.hpp"
+#include "Engine/SpriteSheet.hpp"
 #endif // USE_OPENGL_API
 
 #include <map>
 #include <string>
+#include <utility>
 
 enum class EPopupType
 {
@@ -34,29 +38,38 @@ enum class ENeed
 
 class DialoguePopUp : public Rect
 {
+public:
+    static constexpr const char* s_emotesPath = RESOURCE_PATH "/sprites/emote/";
+
+    static constexpr std::pair<EPopupType, const char*> s_popupFiles[] = {{EPopupType::Dialogue, "emote1_.png"}};
+
+    static constexpr std::pair<ENeed, const char*> s_speachFiles[] = {
+        {ENeed::Love, "heart.png"},      {ENeed::Sleep, "sleep2.png"},     {ENeed::Hungry, "drop1.png"},
+        {ENeed::Sad, "faceSad.png"},     {ENeed::Happy, "faceHappy.png"}, {ENeed::Angry, "faceAngry.png"}};
+
 protected:
     GameData&                     datas;
-    std::string                   emotesPath = RESOURCE_PATH "/sprites/emote/";
+    std::string                   emotesPath = s_emotesPath;
     std::map<EPopupType, Texture> popups;
     std::map<ENeed, Texture>      speachs;
 
-    bool       m_isActive              = false;
-    float      m_displayDuration       = 0.f;
-    float      m_displayerCurrentTimer = 0.f;
-    EPopupType m_backgroundToDisplay;
-    ENeed      m_forgroundToDisplay;
+    bool        m_isActive = false;
+    TimerHandle m_hideTimer;
+    EPopupType  m_backgroundToDisplay;
+    ENeed       m_forgroundToDisplay;
 
 public:
     DialoguePopUp(GameData& data) : datas{data}
     {
-        popups.emplace(EPopupType::Dialogue, (emotesPath + "emote1_.png").c_str());
+        for (auto [type, file] : s_popupFiles)
+        {
+            popups.emplace(type, (emotesPath + file).c_str());
+        }
 
-        speachs.emplace(ENeed::Love, (emotesPath + "heart.png").c_str());
-        speachs.emplace(ENeed::Sleep, (emotesPath + "sleep2.png").c_str());
-        speachs.emplace(ENeed::Hungry, (emotesPath + "drop1.png").c_str());
-        speachs.emplace(ENeed::Sad, (emotesPath + "faceSad.png").c_str());
-        speachs.emplace(ENeed::Happy, (emotesPath + "faceHappy.png").c_str());
-        speachs.emplace(ENeed::Angry, (emotesPath + "faceAngry.png").c_str());
+        for (auto [need, file] : s_speachFiles)
+        {
+            speachs.emplace(need, (emotesPath + file).c_str());
+        }
 
         data.window->addElement(*this);
 
@@ -68,53 +81,29 @@ public:
         datas.window->removeElement(*this);
     }
 
-    void update(double deltaTime)
-    {
-        if (m_isActive)
-        {
-            m_displayerCurrentTimer += deltaTime;
-
-            if (m_displayerCurrentTimer >= m_displayDuration)
-            {
-                m_isActive = false;
-            }
-        }
-    }
-
     void display(float displayDuration, EPopupType backgroundToDisplay, ENeed forgroundToDisplay)
     {
         m_isActive              = true;
-        m_displayerCurrentTimer = 0.f;
-        m_displayDuration       = displayDuration;
         m_backgroundToDisplay   = backgroundToDisplay;
         m_forgroundToDisplay    = forgroundToDisplay;
+        datas.shouldUpdateFrame = true;
+        TimeManager::instance().requestLimitedUpdate();
+
+        m_hideTimer = TimeManager::instance().emplaceTimer(
+            [this]() {
+                m_isActive              = false;
+                datas.shouldUpdateFrame = true;
+                TimeManager::instance().requestLimitedUpdate();
+            },
+            displayDuration);
     }
 
     void drawIfActive()
     {
         if (m_isActive)
         {
-            datas.pSpriteSheetShader->use();
-
-            Vec2 clipSpacePos = Vec2::remap(getCornerMin(), datas.window->getCornerMin(),
-                                            datas.window->getCornerMax(), Vec2{0, 1}, Vec2{1, 0}); // [-1, 1]
-            Vec2 clipSpaceSize =
-                Vec2::remap(getSize(), Vec2{0, 0}, datas.window->getSize(), Vec2{0, 0}, Vec2{1, 1}); // [0, 1]
-
-            // In shader, based on bottom left instead of upper left
-            clipSpacePos.y -= clipSpaceSize.y;
-
-            datas.pSpriteSheetShader->setVec4("uScaleOffSet", 1, 1, 0, 0);
-            datas.pSpriteSheetShader->setVec4("uClipSpacePosSize", clipSpacePos.x, clipSpacePos.y, clipSpaceSize.x,
-                                              clipSpaceSize.y);
-
-            datas.pUnitFullScreenQuad->use();
-
-            popups.at(m_backgroundToDisplay).use();
-            datas.pUnitFullScreenQuad->draw();
-
-            speachs.at(m_forgroundToDisplay).use();
-            datas.pUnitFullScreenQuad->draw();
+            datas.pSpriteRenderer->drawSprite(popups.at(m_backgroundToDisplay), *this);
+            datas.pSpriteRenderer->drawSprite(speachs.at(m_forgroundToDisplay), *this);
         }
     }
 };
@@ -124,53 +113,46 @@ class NeedUpdator
     DialoguePopUp& m_dialoguePopup;
     UtilitySystem& m_utilitySystem;
     GameData&      m_datas;
-    int            lastNeed;
-    bool           leftWasPressed           = false;
-    float          displayPopupCurrentTimer = 0.f;
-    float          nexTimeDisplayPopup      = 0.f;
+    int            lastNeed       = -1;
+    bool           leftWasPressed = false;
+    TimerHandle    m_popupTimer;
+
+    void schedulePopup(float delay)
+    {
+        m_popupTimer = TimeManager::instance().emplaceTimer(
+            [this]() {
+                const bool hasNeed = m_utilitySystem.getPriority() != -1;
+                m_dialoguePopup.display(2.f, EPopupType::Dialogue, hasNeed ? ENeed::Angry : ENeed::Love);
+                schedulePopup(randNum(10000, 30000) / 1000.f);
+            },
+            delay);
+    }
 
 public:
     NeedUpdator(GameData& datas, DialoguePopUp& dialoguePopup, UtilitySystem& utilitySystem)
         : m_datas{datas}, m_dialoguePopup{dialoguePopup}, m_utilitySystem{utilitySystem}
     {
-        nexTimeDisplayPopup = randNum(1000, 3000) / 1000.f;
+        schedulePopup(randNum(1000, 3000) / 1000.f);
+    }
+
+    // Popups are not displayed while paused
+    void setIsPaused(bool isPaused)
+    {
+        if (isPaused)
+            m_popupTimer.cancel();
+        else
+            schedulePopup(randNum(1000, 3000) / 1000.f);
     }
 
     void update(float deltaTime)
     {
         int currentNeedIndex = m_utilitySystem.getPriority();
 
-        if (currentNeedIndex != -1)
-        {
-            if (currentNeedIndex != lastNeed)
-            {
-                m_dialoguePopup.display(1.f, EPopupType::Dialogue, ENeed::Angry);
-                displayPopupCurrentTimer = 0;
-                lastNeed                 = currentNeedIndex;
-                nexTimeDisplayPopup      = randNum(10000, 30000) / 1000.f;
-            }
-            else
-            {
-                displayPopupCurrentTimer += deltaTime;
-
-                if (displayPopupCurrentTimer > nexTimeDisplayPopup)
-                {
-                    displayPopupCurrentTimer -= nexTimeDisplayPopup;
-                    nexTimeDisplayPopup = randNum(10000, 30000) / 1000.f;
-                    m_dialoguePopup.display(2.f, EPopupType::Dialogue, ENeed::Angry);
-                }
-            }
-        }
-        else
+        if (currentNeedIndex != -1 && currentNeedIndex != lastNeed)
         {
-            displayPopupCurrentTimer += deltaTime;
-
-            if (displayPopupCurrentTimer > nexTimeDisplayPopup)
-            {
-                displayPopupCurrentTimer -= nexTimeDisplayPopup;
-                nexTimeDisplayPopup = randNum(10000, 30000) / 1000.f;
-                m_dialoguePopup.display(2.f, EPopupType::Dialogue, ENeed::Love);
-            }
+            m_dialoguePopup.display(1.f, EPopupType::Dialogue, ENeed::Angry);
+            lastNeed = currentNeedIndex;
+            schedulePopup(randNum(10000, 30000) / 1000.f);
         }
 
         for (size_t i = 0; i < m_utilitySystem.needs.size(); i++)
@@ -1,20 +1,35 @@
 #pragma once
 
+#include "Engine/AssetPack.hpp"
+#include "Engine/ControlSocket.hpp"
+#include "Engine/FrameStats.hpp"
+#include "Engine/ImageLoader.hpp"
 #include "Engine/InteractionSystem.hpp"
 #include "Engine/Log.hpp"
+#include "Engine/MetricsWriter.hpp"
 #include "Engine/PhysicSystem.hpp"
+#include "Engine/Profiler.hpp"
 #include "Engine/Settings.hpp"
 #include "Engine/SpriteSheet.hpp"
 #include "Engine/StylePanel.hpp"
+#include "Engine/SystemInfo.hpp"
+#include "Game/AnimationGraph.hpp"
 #include "Game/ContextualMenu.hpp"
+#include "Game/ProfilerMenu.hpp"
 #include "Game/SettingMenu.hpp"
 #include "Game/UpdateMenu.hpp"
 #include "Game/GameData.hpp"
 #include "Game/Pet.hpp"
 
 #ifdef USE_OPENGL_API
+#include "Engine/Graphics/CollisionQueryOGL.hpp"
+#include "Engine/Graphics/GLStateOGL.hpp"
+#include "Engine/Graphics/GPUProfilerOGL.hpp"
+#include "Engine/Graphics/PostProcessOGL.hpp"
 #include "Engine/Graphics/ScreenSpaceQuadOGL.hpp"
 #include "Engine/Graphics/ShaderOGL.hpp"
+#include "Engine/Graphics/SpriteRendererCPU.hpp"
+#include "Engine/Graphics/SpriteRendererOGL.hpp"
 #include "Engine/Graphics/TextureOGL.hpp"
 #endif // USE_OPENGL_API
 
@@ -29,7 +44,14 @@
 
 #include <GLFW/glfw3.h>
 
+#include "yaml-cpp/yaml.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <cstring>
 #include <functional>
+#include <thread>
 
 class Game
 {
@@ -37,7 +59,58 @@ protected:
     GameData     datas;
     PhysicSystem physicSystem;
 
+    // Draw calls submitted by ImGui since the last reset
+    size_t m_UIDrawCallCount = 0;
+
+    MetricsWriter m_metricsWriter;
+    ControlSocket m_controlSocket;
+
+    // Physic only runs at its frame rate while a pet moves or is grabbed
+    enum class EPhysicSleep : uint8_t
+    {
+        Awake,
+        GroundProbe, // All the pets are at rest, the ground is checked so that they fall if their window moves
+        Asleep       // All the pets are at rest on the bottom of a monitor
+    };
+
+    TimerHandle  m_physicTimer;
+    int          m_physicTimerFrameRate = 0; // Period of m_physicTimer
+    EPhysicSleep m_physicSleep          = EPhysicSleep::Awake;
+
+    static constexpr double      s_groundProbePeriod = 0.5; // In seconds
+    static constexpr const char* s_physicSleepNames[] = {"awake", "groundProbe", "asleep"};
+
+    static constexpr size_t s_maxControlledPetCount = 1024;
+
 protected:
+    // Start the decoding of the images used at startup while the window and the graphic context are created
+    void requestAssets()
+    {
+        ImageLoader& loader = ImageLoader::instance();
+
+        YAML::Node nodesSection = YAML::LoadFile(RESOURCE_PATH "/setting/animation.yaml")["Nodes"];
+        for (YAML::const_iterator it = nodesSection.begin(); it != nodesSection.end(); ++it)
+        {
+            YAML::Node spriteNode = it->second["sprite"];
+            if (spriteNode)
+                loader.requestImage(RESOURCE_PATH "/sprites/" + spriteNode.as<std::string>(), true);
+        }
+
+        for (auto [type, file] : DialoguePopUp::s_popupFiles)
+        {
+            loader.requestImage(std::string(DialoguePopUp::s_emotesPath) + file, true);
+        }
+
+        for (auto [need, file] : DialoguePopUp::s_speachFiles)
+        {
+            loader.requestImage(std::string(DialoguePopUp::s_emotesPath) + file, true);
+        }
+
+        loader.requestImage(RESOURCE_PATH "/sprites/logo/discord-mark-blue.png", false);
+        loader.requestImage(RESOURCE_PATH "/sprites/logo/Digital-Patreon-Logo_FieryCoral.png", false);
+        loader.requestFile(RESOURCE_PATH "/fonts/NimbusSanL-Reg.otf");
+    }
+
     void createResources()
     {
         datas.pFramebuffer = std::make_unique<Framebuffer>();
@@ -45,9 +118,16 @@ protected:
         datas.pUnitFullScreenQuad = std::make_unique<ScreenSpaceQuad>(*datas.window, 0.f, 1.f);
         datas.pFullScreenQuad     = std::make_unique<ScreenSpaceQuad>(*datas.window, -1.f, 1.f);
 
-        datas.edgeDetectionShaders.emplace_back(
-            std::make_unique<Shader>(*datas.window, SHADER_RESOURCE_PATH "/image" SHADER_VERTEX_EXT,
-                                     SHADER_RESOURCE_PATH "/dFdxEdgeDetection" SHADER_FRAG_EXT));
+        datas.pEdgeDetection =
+            std::make_unique<PostProcess>(*datas.window, RESOURCE_PATH "/setting/edgeDetection.yaml");
+
+        if (datas.computeCollision)
+        {
+            if (CollisionQuery::isSupported())
+                datas.pCollisionQuery = std::make_unique<CollisionQuery>(*datas.window);
+            else
+                logf(ELogLevel::Warning, "Compute collision needs OpenGL 4.5, the edge mask is read back instead\n");
+        }
 
         datas.pImageShader = std::make_unique<Shader>(*datas.window, SHADER_RESOURCE_PATH "/image" SHADER_VERTEX_EXT,
                                                       SHADER_RESOURCE_PATH "/image" SHADER_FRAG_EXT);
@@ -58,24 +138,62 @@ protected:
                                          SHADER_RESOURCE_PATH "/imageGreyScale" SHADER_FRAG_EXT);
 
         datas.pSpriteSheetShader =
-            std::make_unique<Shader>(*datas.window, SHADER_RESOURCE_PATH "/spriteSheet" SHADER_VERTEX_EXT,
+            std::make_unique<SpriteSheetShader>(*datas.window, SHADER_RESOURCE_PATH "/spriteSheet" SHADER_VERTEX_EXT,
                                      SHADER_RESOURCE_PATH "/image" SHADER_FRAG_EXT);
 
+        const bool useCPUSprites = datas.spriteRenderer == "CPU" ||
+                                   (datas.spriteRenderer != "OpenGL" && datas.window->getIsSoftwareRenderer());
+        if (useCPUSprites)
+            datas.pSpriteRenderer =
+                std::make_unique<SpriteRendererCPU>(*datas.window, *datas.pImageShader, *datas.pFullScreenQuad);
+        else
+            datas.pSpriteRenderer = std::make_unique<SpriteRendererOGL>(*datas.window, *datas.pSpriteSheetShader,
+                                                                        *datas.pUnitFullScreenQuad);
+        logf("Sprites are blended by %s\n", useCPUSprites ? "the CPU" : "OpenGL");
+
 
         datas.pDiscordLogo =
             std::make_unique<Texture>(RESOURCE_PATH "/sprites/logo/discord-mark-blue.png", false, Texture::linearClampSampling);
         datas.pPatreonLogo = std::make_unique<Texture>(RESOURCE_PATH "/sprites/logo/Digital-Patreon-Logo_FieryCoral.png", false,
                                                        Texture::linearClampSampling);
+
+        if (datas.GPUProfiling)
+            GPUProfiler::instance().start(datas.GPUProfileFile.c_str());
     }
 
 public:
-    Game() : physicSystem(datas)
+    // Headless mode use an offscreen context without display (see Window::init)
+    Game(bool headless = false) : physicSystem(datas)
     {
+        PROFILE_THREAD("Main");
+
+        // Startup timing report
+        using Clock                            = std::chrono::steady_clock;
+        const Clock::time_point startTime      = Clock::now();
+        Clock::time_point       stepStartTime  = startTime;
+        const auto              getStepDuration_ms = [&]() {
+            const Clock::time_point now      = Clock::now();
+            const double            duration = std::chrono::duration<double, std::milli>(now - stepStartTime).count();
+            stepStartTime                    = now;
+            return duration;
+        };
+
         logf("%s %s\n", PROJECT_NAME, PROJECT_VERSION);
         
         Setting::instance().importFile(RESOURCE_PATH "/setting/setting.yaml", datas);
+        datas.headless = headless;
         TimeManager::instance().Init(datas);
 
+        // Optional, generated by the pack_assets target. Images missing from the pack are decoded from the loose files.
+        AssetPack::instance().open(RESOURCE_PATH "/sprites.pack");
+
+        if (datas.parallelAssetLoading)
+        {
+            ImageLoader::instance().start(std::clamp(std::thread::hardware_concurrency(), 2u, 5u) - 1u);
+            requestAssets();
+        }
+        const double settingDuration_ms = getStepDuration_ms();
+
         glfwSetMonitorCallback(setMonitorCallback);
         datas.window = std::make_unique<Window>();
         datas.window->init(datas);
@@ -83,7 +201,8 @@ public:
         Vec2i monitorSize    = datas.monitors.getMonitorsSize();
         Vec2i monitorsSizeMM = datas.monitors.getMonitorPhysicalSize();
 
-        if (datas.fullScreenWindow)
+        // Full screen can be refused by the window on software renderers
+        if (!datas.window->getUseFitToElements())
         {
             datas.window->setSize(monitorSize);
         }
@@ -97,17 +216,32 @@ public:
                                (float)monitorSize.y / (monitorsSizeMM.y * 0.001f)};
 
         datas.interactionSystem = std::make_unique<InteractionSystem>();
+        const double windowDuration_ms = getStepDuration_ms();
 
         initUI(datas);
+        const double UIDuration_ms = getStepDuration_ms();
 
         createResources();
+        datas.animationGraph = std::make_unique<AnimationGraph>(RESOURCE_PATH "/setting/animation.yaml");
+        const double resourcesDuration_ms = getStepDuration_ms();
 
         srand(datas.randomSeed == -1 ? (unsigned)time(nullptr) : datas.randomSeed);
 
 #if NDEBUG // Check for update only on release to avoid harassing the server
-        Updater::instance().checkForUpdate(datas);
+        if (!datas.headless)
+            Updater::instance().checkForUpdate(datas);
 #endif
         datas.pets.emplace_back(std::make_shared<Pet>(datas));
+        const double petDuration_ms = getStepDuration_ms();
+
+        // Workers are only used during startup
+        ImageLoader::instance().stop();
+
+        logf("Startup with %s asset loading: settings %.1fms, window %.1fms, UI %.1fms, resources %.1fms, pet %.1fms, "
+             "total %.1fms\n",
+             datas.parallelAssetLoading ? "parallel" : "serial", settingDuration_ms, windowDuration_ms, UIDuration_ms,
+             resourcesDuration_ms, petDuration_ms,
+             std::chrono::duration<double, std::milli>(Clock::now() - startTime).count());
     }
 
     void initUI(GameData& datas)
@@ -120,7 +254,14 @@ public:
         // Load style
         bool useDefaultProfile = true;
         setDefaultTheme(); // fallback theme
-        io.Fonts->AddFontFromFileTTF(RESOURCE_PATH "/fonts/NimbusSanL-Reg.otf", 14 * datas.textScale);
+        std::vector<char> fontFile = ImageLoader::instance().takeFile(RESOURCE_PATH "/fonts/NimbusSanL-Reg.otf");
+        if (!fontFile.empty())
+        {
+            // Font atlas take the ownership of the data
+            void* fontData = IM_ALLOC(fontFile.size());
+            memcpy(fontData, fontFile.data(), fontFile.size());
+            io.Fonts->AddFontFromMemoryTTF(fontData, static_cast<int>(fontFile.size()), 14 * datas.textScale);
+        }
 
         // Get all styles
         for (const auto& entry : fs::directory_iterator(RESOURCE_PATH "/styles"))
@@ -143,11 +284,17 @@ public:
 
         // Setup Platform/Renderer backends
         ImGui_ImplGlfw_InitForOpenGL(datas.window->getWindow(), true);
-        ImGui_ImplOpenGL3_Init("#version 460");
+        ImGui_ImplOpenGL3_Init("#version 450");
     }
 
     ~Game()
     {
+#ifdef USE_PROFILER
+        Profiler::instance().saveChromeTrace("profiler_trace.json");
+#endif // USE_PROFILER
+
+        // Queries are deleted with the context
+        GPUProfiler::instance().stop();
         cleanUI();
         glfwTerminate();
     }
@@ -164,7 +311,7 @@ public:
             ++frameCount;
 
             // render
-            datas.window->initDrawContext();
+            datas.window->initDrawContext(true);
 
             if (!(frameCount & 1) && datas.pImageGreyScale && datas.pEdgeDetectionTexture && datas.pFullScreenQuad)
             {
@@ -209,10 +356,30 @@ public:
         ImGui::NewFrame();
     }
 
-    void renderUI()
+    void prepareUIRendering()
     {
         ImGui::Render();
+
+        // ImGui popups and tooltips can be drawn outside of the menus area
+        const ImDrawData* drawData = ImGui::GetDrawData();
+        for (int i = 0; i < drawData->CmdListsCount; ++i)
+        {
+            m_UIDrawCallCount += drawData->CmdLists[i]->CmdBuffer.Size;
+            FrameStats::instance().addDrawCalls(drawData->CmdLists[i]->CmdBuffer.Size);
+            for (const ImDrawCmd& cmd : drawData->CmdLists[i]->CmdBuffer)
+            {
+                datas.window->addDamage(datas.window->getPosition() + Vec2{cmd.ClipRect.x, cmd.ClipRect.y},
+                                        datas.window->getPosition() + Vec2{cmd.ClipRect.z, cmd.ClipRect.w});
+            }
+        }
+    }
+
+    void renderUI()
+    {
         ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+
+        // The backend sets the state directly
+        GLState::instance().invalidate();
     }
 
     void cleanUI()
@@ -222,79 +389,321 @@ public:
         ImGui::DestroyContext();
     }
 
-    void run()
+    // Without visual change and menu, the limited update can wait for the next sprite animation frame. Animation
+    // transitions request the update when their event is raised.
+    double computeLimitedUpdateDelay() const
     {
-        if (datas.debugEdgeDetection)
+        if (datas.shouldUpdateFrame || datas.contextualMenu || datas.settingMenu || datas.updateMenu ||
+            datas.profilerMenu)
+            return 0.;
+
+        float delay = FLT_MAX;
+        for (const std::shared_ptr<Pet>& pet : datas.pets)
         {
-            runCollisionDetectionMode();
-            return;
+            delay = std::min(delay, pet->getTimeBeforeNextAnimationFrame());
         }
+        return delay;
+    }
 
-        const std::function<void(double)> unlimitedUpdate{[&](double deltaTime) {
-            processInput(datas.window->getWindow());
+    // Update the menus and draw the pets and the UI
+    void updateAndRenderFrame(double deltaTime)
+    {
+        // Before UI update so that ImGui windows are placed relative to the new window position
+        datas.window->fitToElements();
 
-            // poll for and process events
-            glfwPollEvents();
+        {
+            FrameStageTimer stageTimer(EFrameStage::UI);
+            updateUI();
 
-            datas.interactionSystem->update(datas);
+            // TODO: make generic class to avoid code repetition
+            if (datas.contextualMenu != nullptr)
+            {
+                datas.contextualMenu->update(deltaTime);
 
-            for (const std::shared_ptr<Pet>& pet : datas.pets)
+                if (datas.contextualMenu->getShouldClose())
+                    datas.contextualMenu = nullptr;
+            }
+
+            if (datas.settingMenu != nullptr)
             {
-                pet->update(deltaTime);
+                datas.settingMenu->update(deltaTime);
+
+                if (datas.settingMenu->getShouldClose())
+                    datas.settingMenu = nullptr;
             }
-        }};
 
-        const std::function<void(double)> limitedUpdate{[&](double deltaTime) {
-            for (const std::shared_ptr<Pet>& pet : datas.pets)
+            if (datas.updateMenu != nullptr)
             {
-                pet->updateRendering(deltaTime);
+                datas.updateMenu->update(deltaTime);
+
+                if (datas.updateMenu->getShouldClose())
+                    datas.updateMenu = nullptr;
             }
 
-            if (datas.shouldUpdateFrame)
+            if (datas.profilerMenu != nullptr)
             {
-                updateUI();
+                datas.profilerMenu->update(deltaTime);
 
-                // TODO: make generic class to avoid code repetition
-                if (datas.contextualMenu != nullptr)
-                {
-                    datas.contextualMenu->update(deltaTime);
+                if (datas.profilerMenu->getShouldClose())
+                    datas.profilerMenu = nullptr;
+            }
 
-                    if (datas.contextualMenu->getShouldClose())
-                        datas.contextualMenu = nullptr;
-                }
+            prepareUIRendering();
+        }
+
+        {
+            PROFILE_SCOPE("Draw");
+            FrameStageTimer stageTimer(EFrameStage::Draw);
+            const Canvas::DamageRegion damage = datas.window->initDrawContext();
 
-                if (datas.settingMenu != nullptr)
+            // render
+            {
+                GPUPassScope spritesPass(EGPUPass::Sprites);
+                datas.pSpriteRenderer->beginFrame(damage);
+                for (const std::shared_ptr<Pet>& pet : datas.pets)
                 {
-                    datas.settingMenu->update(deltaTime);
+                    pet->draw();
+                }
+                datas.pSpriteRenderer->endFrame();
+            }
+
+            FrameStageTimer UIStageTimer(EFrameStage::UI);
+            GPUPassScope    UIPass(EGPUPass::UI);
+            renderUI();
+        }
+
+        // swap front and back buffers
+        {
+            PROFILE_SCOPE("Swap buffers");
+            FrameStageTimer stageTimer(EFrameStage::Present);
+            datas.window->renderFrame();
+        }
+        TimeManager::instance().markFramePresented();
+        FrameStats::instance().endFrame();
+        GPUProfiler::instance().endFrame();
+        datas.shouldUpdateFrame = false;
+    }
+
+    void writeMetrics()
+    {
+        const FrameStats& frameStats = FrameStats::instance();
+        m_metricsWriter.addHistogram("petfordesktop_frame_time_seconds", "Main thread time of the rendered frames",
+                                     FrameStats::s_frameTimeBuckets_s, frameStats.getFrameTimeBucketCounts(),
+                                     FrameStats::s_frameTimeBucketCount, frameStats.getFrameCount(),
+                                     frameStats.getFrameTimeSum_s());
+        m_metricsWriter.addCounter("petfordesktop_physic_updates_total", "Physic steps of all the pets",
+                                   static_cast<double>(physicSystem.getUpdateCount()));
+        m_metricsWriter.addCounter("petfordesktop_capture_bytes_total", "Screen captured for the collisions",
+                                   static_cast<double>(physicSystem.getCaptureByteCount()));
+        m_metricsWriter.addCounter("petfordesktop_dropped_physic_seconds_total",
+                                   "Time not simulated because of too long frames",
+                                   TimeManager::instance().getDroppedTime());
+        m_metricsWriter.addGauge("petfordesktop_pets", "Pets on the desktop", static_cast<double>(datas.pets.size()));
+        m_metricsWriter.addGauge("petfordesktop_resident_memory_bytes", "Resident memory of the process",
+                                 static_cast<double>(getProcessResidentMemory()));
+        m_metricsWriter.addGauge("petfordesktop_gpu_texture_bytes", "Size of the textures",
+                                 static_cast<double>(Texture::getTotalGPUByteCount()));
+        m_metricsWriter.writeFile(datas.metricsFile);
+    }
+
+    // One JSON object per line, the response is {"ok":true,...} or {"ok":false,"error":"..."}:
+    // {"cmd":"spawn","count":10}, {"cmd":"remove","count":10} (at least one pet is kept)
+    // {"cmd":"pause","paused":true,"pet":0}, {"cmd":"move","x":100,"y":200,"pet":0}, {"cmd":"throw","vx":5,"vy":-5}
+    // {"cmd":"set","settings":{"Physic":{"Bounciness":0.2}}} with the sections and keys of setting.yaml
+    // {"cmd":"stats"}
+    // Input goes through the window callbacks, like the real cursor (desktop coordinates):
+    // {"cmd":"cursor","x":100,"y":200}, {"cmd":"press","button":"left"}, {"cmd":"release","button":"right"}
+    // {"cmd":"cursor","controlled":false} gives the cursor back to the mouse.
+    // Commands taking "pet" apply to all the pets without it.
+    void handleControlRequest(const std::string& request, std::string& response)
+    {
+        char buffer[512];
+        try
+        {
+            const YAML::Node  node    = YAML::Load(request);
+            const std::string command = node["cmd"].as<std::string>("");
 
-                    if (datas.settingMenu->getShouldClose())
-                        datas.settingMenu = nullptr;
+            const auto forEachTargetPet = [&](const auto& function) {
+                if (!node["pet"])
+                {
+                    for (const std::shared_ptr<Pet>& pet : datas.pets)
+                        function(*pet);
+                    return true;
                 }
 
-                if (datas.updateMenu != nullptr)
+                const size_t index = node["pet"].as<size_t>();
+                if (index >= datas.pets.size())
+                    return false;
+                function(*datas.pets[index]);
+                return true;
+            };
+
+            bool isPetFound = true;
+            if (command == "spawn")
+            {
+                const size_t freeCount = s_maxControlledPetCount - std::min(datas.pets.size(), s_maxControlledPetCount);
+                const size_t count     = std::min(node["count"].as<size_t>(1), freeCount);
+                for (size_t i = 0; i < count; ++i)
                 {
-                    datas.updateMenu->update(deltaTime);
+                    datas.pets.emplace_back(std::make_shared<Pet>(datas));
+                }
+            }
+            else if (command == "remove")
+            {
+                // Menus can refer to the removed pets
+                datas.contextualMenu = nullptr;
+                datas.settingMenu    = nullptr;
 
-                    if (datas.updateMenu->getShouldClose())
-                        datas.updateMenu = nullptr;
+                const size_t count = std::min(node["count"].as<size_t>(1), datas.pets.size() - 1);
+                datas.pets.resize(datas.pets.size() - count);
+            }
+            else if (command == "pause")
+            {
+                const bool isPaused = node["paused"].as<bool>(true);
+                isPetFound          = forEachTargetPet([&](Pet& pet) { pet.setIsPaused(isPaused); });
+            }
+            else if (command == "move")
+            {
+                // Like a drop after a drag, in desktop coordinates: the pet falls from there and the physic wakes up
+                const Vec2 position{node["x"].as<float>(), node["y"].as<float>()};
+                isPetFound = forEachTargetPet([&](Pet& pet) {
+                    PhysicComponent& physic = pet.getPhysicComponent();
+                    pet.setPosition(position);
+                    physic.velocity           = {0.f, 0.f};
+                    physic.isGrounded         = false;
+                    physic.isOnBottomOfWindow = false;
+                    pet.raiseAnimationEvent(AnimationState::GroundedChanged);
+                });
+                TimeManager::instance().requestLimitedUpdate();
+            }
+            else if (command == "throw")
+            {
+                const Vec2 velocity{node["vx"].as<float>(0.f), node["vy"].as<float>(0.f)};
+                isPetFound = forEachTargetPet([&](Pet& pet) { pet.getPhysicComponent().velocity = velocity; });
+            }
+            else if (command == "set")
+            {
+                Setting::instance().importValues(node["settings"], datas);
+                TimeManager::instance().setFrameRate(datas.FPS);
+                if (datas.physicFrameRate != m_physicTimerFrameRate)
+                    startPhysicTimer();
+            }
+            else if (command == "cursor")
+            {
+                datas.isCursorControlled = node["controlled"].as<bool>(true);
+                if (datas.isCursorControlled)
+                {
+                    const Vec2i  windowPosition = datas.window->getPosition();
+                    const double x              = node["x"].as<double>() - windowPosition.x;
+                    const double y              = node["y"].as<double>() - windowPosition.y;
+                    datas.cursorPos             = {static_cast<int>(floor(x)), static_cast<int>(floor(y))};
+                    cursorPositionCallback(datas.window->getWindow(), x, y);
+                }
+            }
+            else if (command == "press" || command == "release")
+            {
+                const std::string button = node["button"].as<std::string>("left");
+                if (button != "left" && button != "right")
+                {
+                    response = "{\"ok\":false,\"error\":\"Unknown button\"}";
+                    return;
                 }
+                mousButtonCallBack(datas.window->getWindow(),
+                                   button == "left" ? GLFW_MOUSE_BUTTON_LEFT : GLFW_MOUSE_BUTTON_RIGHT,
+                                   command == "press" ? GLFW_PRESS : GLFW_RELEASE, 0);
+            }
+            else if (command == "stats")
+            {
+                const FrameStats& frameStats = FrameStats::instance();
+                snprintf(buffer, sizeof(buffer),
+                         "{\"ok\":true,\"pets\":%zu,\"fps\":%.1f,\"wakeUpsPerSecond\":%.1f,\"CPUUsage\":%.1f,"
+                         "\"frameTimeP50_ms\":%.3f,\"frameTimeP99_ms\":%.3f,\"frames\":%zu,\"physicUpdates\":%llu,"
+                         "\"captureBytes\":%llu,\"residentMemory\":%zu,\"inputLatency_ms\":%.1f,"
+                         "\"physicSleep\":\"%s\"}",
+                         datas.pets.size(), ImGui::GetIO().Framerate, TimeManager::instance().getWakeUpsPerSecond(),
+                         TimeManager::instance().getCPUUsage(), frameStats.computeTotalPercentile_ms(0.5f),
+                         frameStats.computeTotalPercentile_ms(0.99f), frameStats.getFrameCount(),
+                         static_cast<unsigned long long>(physicSystem.getUpdateCount()),
+                         static_cast<unsigned long long>(physicSystem.getCaptureByteCount()),
+                         getProcessResidentMemory(), TimeManager::instance().getInputLatency_ms(),
+                         s_physicSleepNames[static_cast<size_t>(m_physicSleep)]);
+                response = buffer;
+                return;
+            }
+            else
+            {
+                response = "{\"ok\":false,\"error\":\"Unknown command\"}";
+                return;
+            }
+
+            if (!isPetFound)
+            {
+                response = "{\"ok\":false,\"error\":\"Pet index out of range\"}";
+                return;
+            }
+
+            datas.shouldUpdateFrame = true;
+            snprintf(buffer, sizeof(buffer), "{\"ok\":true,\"pets\":%zu}", datas.pets.size());
+            response = buffer;
+        }
+        catch (const YAML::Exception& exception)
+        {
+            response = "{\"ok\":false,\"error\":";
+            ControlSocket::appendJSONString(response, exception.what());
+            response += '}';
+        }
+    }
 
-                datas.window->initDrawContext();
+    // Restarted when the physic frame rate or the sleep state changes
+    void startPhysicTimer()
+    {
+        m_physicTimerFrameRate = datas.physicFrameRate;
+        if (m_physicSleep == EPhysicSleep::Asleep)
+        {
+            m_physicTimer.cancel();
+            return;
+        }
 
-                // render
+        const double period =
+            m_physicSleep == EPhysicSleep::GroundProbe ? s_groundProbePeriod : 1. / m_physicTimerFrameRate;
+        m_physicTimer = TimeManager::instance().emplaceTimer(
+            [this, period]() {
                 for (const std::shared_ptr<Pet>& pet : datas.pets)
                 {
-                    pet->draw();
+                    physicSystem.update(pet->getPhysicComponent(), pet->getInteractionComponent(), period);
                 }
+            },
+            period, true);
+    }
 
-                renderUI();
-
-                // swap front and back buffers
-                datas.window->renderFrame();
-                datas.shouldUpdateFrame = false;
+    // Called after each update so that the input, the timers and the animation events (ex: walk) that give a pet a
+    // velocity wake the physic before its next step
+    void updatePhysicSleep()
+    {
+        EPhysicSleep physicSleep = EPhysicSleep::Asleep;
+        for (const std::shared_ptr<Pet>& pet : datas.pets)
+        {
+            const PhysicComponent& physic = pet->getPhysicComponent();
+            if (!physic.isGrounded || physic.velocity.sqrLength() != 0.f ||
+                physic.continuousVelocity.sqrLength() != 0.f || pet->getInteractionComponent().isLeftSelected)
+            {
+                physicSleep = EPhysicSleep::Awake;
+                break;
             }
-        }};
 
+            if (!physic.isOnBottomOfWindow)
+                physicSleep = EPhysicSleep::GroundProbe;
+        }
+
+        if (physicSleep != m_physicSleep)
+        {
+            m_physicSleep = physicSleep;
+            startPhysicTimer();
+        }
+    }
+
+    void placePetsOnMainMonitor()
+    {
         Vec2i mainMonitorPosition;
         Vec2i mainMonitorSize;
         datas.monitors.getMainMonitorWorkingArea(mainMonitorPosition, mainMonitorSize);
@@ -305,21 +714,158 @@ public:
             petPosition.x += mainMonitorSize.x / (datas.pets.size() + 1) * (i + 1);
             datas.pets[i]->setPosition(petPosition);
         }
+    }
+
+    // Render frameCount frames with petCount pets and the contextual and setting menus open, then log the CPU time,
+    // the draw calls and the heap allocations per frame. Each frame runs a physic step where every pet probes its
+    // ground, through the continuous collision (screen capture, upload, edge detection and query or readback).
+    // Return the number of allocations of the measured frames, 0 once the frame reached its steady state.
+    size_t runRenderBenchmark(size_t petCount, size_t frameCount)
+    {
+        while (datas.pets.size() < petCount)
+        {
+            datas.pets.emplace_back(std::make_shared<Pet>(datas));
+        }
+        placePetsOnMainMonitor();
 
-        TimeManager::instance().emplaceTimer(
-            [&]() {
+        Pet& menuOwner = *datas.pets.front();
+        menuOwner.onRightClic();
+        datas.settingMenu = std::make_unique<SettingMenu>(datas, menuOwner, menuOwner.getPosition());
+        datas.window->addElement(*datas.settingMenu);
+
+        // Fixed step so that the runs are reproducible
+        const double deltaTime = 1. / 60.;
+        const auto   runFrames = [&](size_t count) {
+            for (size_t i = 0; i < count; ++i)
+            {
                 for (const std::shared_ptr<Pet>& pet : datas.pets)
                 {
-                    physicSystem.update(pet->getPhysicComponent(), pet->getInteractionComponent(),
-                                        1.f / datas.physicFrameRate);
+                    // Standing still above the bottom of the monitor, so that the step probes the ground
+                    PhysicComponent& physic   = pet->getPhysicComponent();
+                    physic.isGrounded         = true;
+                    physic.isOnBottomOfWindow = false;
+                    physic.velocity           = {0.f, 0.f};
+                    physic.continuousVelocity = {0.f, 0.f};
+                    physicSystem.update(physic, pet->getInteractionComponent(), deltaTime);
                 }
-            },
-            1.f / datas.physicFrameRate, true);
+
+                for (const std::shared_ptr<Pet>& pet : datas.pets)
+                {
+                    pet->update(deltaTime);
+                }
+                datas.animationGraph->update(datas.pets, datas, deltaTime);
+                for (const std::shared_ptr<Pet>& pet : datas.pets)
+                {
+                    pet->updateRendering(deltaTime);
+                }
+                datas.shouldUpdateFrame = true;
+                updateAndRenderFrame(deltaTime);
+            }
+            // Include the deferred work of the driver
+            glFinish();
+        };
+
+        // Warm up shader compilation, font atlas upload and driver caches
+        runFrames(std::min<size_t>(frameCount, 10));
+
+        ScreenSpaceQuad::resetDrawCallCount();
+        m_UIDrawCallCount = 0;
+        const GLState& state                = GLState::instance();
+        const uint64_t stateCallCountStart  = state.getCallCount();
+        const uint64_t elidedCallCountStart = state.getElidedCallCount();
+        const double   cpuTimeStart         = getProcessCPUTime();
+        const auto     wallStart            = std::chrono::steady_clock::now();
+        const size_t   allocationCountStart = getAllocationCount();
+
+        runFrames(frameCount);
+
+        const size_t   allocationCount = getAllocationCount() - allocationCountStart;
+        const uint64_t elidedCallCount = state.getElidedCallCount() - elidedCallCountStart;
+        const uint64_t GLCallCount     = state.getCallCount() - stateCallCountStart - elidedCallCount;
+        const double cpuTime         = getProcessCPUTime() - cpuTimeStart;
+        const double wallTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+        const double frames   = static_cast<double>(std::max<size_t>(frameCount, 1));
+        logf("Render benchmark (%s, %zu pets, %zu frames): %.3fms CPU/frame, %.3fms wall/frame, %.1f sprite draw "
+             "calls/frame, %.1f UI draw calls/frame, %.1f GL state calls/frame (%.1f more elided), %.2f "
+             "allocations/frame\n",
+             reinterpret_cast<const char*>(glGetString(GL_RENDERER)), datas.pets.size(), frameCount,
+             cpuTime * 1000. / frames, wallTime * 1000. / frames, ScreenSpaceQuad::getDrawCallCount() / frames,
+             m_UIDrawCallCount / frames, GLCallCount / frames, elidedCallCount / frames, allocationCount / frames);
+        return allocationCount;
+    }
+
+    void run()
+    {
+        if (datas.debugEdgeDetection)
+        {
+            runCollisionDetectionMode();
+            return;
+        }
+
+        if (!datas.controlSocketPath.empty())
+            m_controlSocket.open(datas.controlSocketPath);
+
+        const ControlSocket::RequestHandler controlRequestHandler{
+            [this](const std::string& request, std::string& response) { handleControlRequest(request, response); }};
+
+        const std::function<void(double)> unlimitedUpdate{[&](double deltaTime) {
+            // sleep until the next deadline or the next event
+            TimeManager::instance().setLimitedUpdateDelay(computeLimitedUpdateDelay());
+            const double timeBeforeNextDeadline = TimeManager::instance().getTimeBeforeNextDeadline();
+            {
+                PROFILE_SCOPE("Wait events");
+                if (timeBeforeNextDeadline > 0.)
+                    glfwWaitEventsTimeout(timeBeforeNextDeadline);
+                else
+                    glfwPollEvents();
+            }
+
+            FrameStageTimer stageTimer(EFrameStage::Input);
+            processInput(datas.window->getWindow());
+
+            datas.interactionSystem->update(datas);
+
+            m_controlSocket.poll(controlRequestHandler);
+
+            for (const std::shared_ptr<Pet>& pet : datas.pets)
+            {
+                pet->update(deltaTime);
+            }
+        }};
+
+        const std::function<void(double)> limitedUpdate{[&](double deltaTime) {
+            datas.animationGraph->update(datas.pets, datas, deltaTime);
+            for (const std::shared_ptr<Pet>& pet : datas.pets)
+            {
+                pet->updateRendering(deltaTime);
+            }
+
+            if (datas.shouldUpdateFrame)
+                updateAndRenderFrame(deltaTime);
+        }};
+
+        placePetsOnMainMonitor();
+
+        if (datas.showProfiler)
+        {
+            Vec2i mainMonitorPosition;
+            Vec2i mainMonitorSize;
+            datas.monitors.getMainMonitorWorkingArea(mainMonitorPosition, mainMonitorSize);
+            datas.profilerMenu = std::make_unique<ProfilerMenu>(datas, mainMonitorPosition + mainMonitorSize / 2);
+        }
+
+        startPhysicTimer();
+
+        TimerHandle metricsTimer;
+        if (!datas.metricsFile.empty())
+            metricsTimer =
+                TimeManager::instance().emplaceTimer([this]() { writeMetrics(); }, datas.metricsPeriod, true);
 
         TimeManager::instance().start();
         while (!datas.window->shouldClose())
         {
             TimeManager::instance().update(unlimitedUpdate, limitedUpdate);
+            updatePhysicSleep();
         }
     }
 };
\ No newline at end of file
@@ -1,11 +1,11 @@
 #pragma once
 
+#include "Engine/CursorTracker.hpp"
 #include "Engine/Monitors.hpp"
 #include "Engine/Vector2.hpp"
 
 #include <filesystem>
 #include <memory>
-#include <queue>
 #include <string>
 #include <vector>
 
@@ -17,9 +17,11 @@ struct GameData
 
     // Represente the window with all sub windows
     std::vector<std::shared_ptr<class Pet>> pets;
+    std::unique_ptr<class AnimationGraph>   animationGraph; // Shared by all the pets
     std::unique_ptr<class ContextualMenu>   contextualMenu;
     std::unique_ptr<class SettingMenu>      settingMenu;
     std::unique_ptr<class UpdateMenu>      updateMenu;
+    std::unique_ptr<class ProfilerMenu>    profilerMenu;
 
     bool shouldUpdateFrame = true;
 
@@ -28,48 +30,42 @@ struct GameData
 
     std::unique_ptr<class Shader>              pImageShader       = nullptr;
     std::unique_ptr<class Shader>              pImageGreyScale    = nullptr;
-    std::unique_ptr<class Shader>              pSpriteSheetShader = nullptr;
-    std::vector<std::unique_ptr<class Shader>> edgeDetectionShaders; // Sorted by pass
+    std::unique_ptr<class SpriteSheetShader>   pSpriteSheetShader = nullptr;
+    std::unique_ptr<class PostProcess>         pEdgeDetection     = nullptr; // From the capture to the edge mask
+    std::unique_ptr<class SpriteRenderer>      pSpriteRenderer    = nullptr;
 
     std::unique_ptr<class Texture> pDiscordLogo          = nullptr;
     std::unique_ptr<class Texture> pPatreonLogo          = nullptr;
     std::unique_ptr<class Texture> pCollisionTexture     = nullptr;
     std::unique_ptr<class Texture> pEdgeDetectionTexture = nullptr;
 
+    std::unique_ptr<class CollisionQuery> pCollisionQuery = nullptr; // If computeCollision is supported
+
     std::unique_ptr<class ScreenSpaceQuad> pUnitFullScreenQuad = nullptr;
     std::unique_ptr<class ScreenSpaceQuad> pFullScreenQuad     = nullptr;
 
     Vec2i cursorPos;
-    float prevCursorPosX   = 0;
-    float prevCursorPosY   = 0;
-    float deltaCursorPosX  = 0;
-    float deltaCursorPosY  = 0;
-    int   leftButtonEvent  = 0;
-    int   rightButtonEvent = 0;
-
-    struct DeltaCursosPosElem
-    {
-        float timer;
-        Vec2  pos;
-
-        bool operator>(const DeltaCursosPosElem& other) const noexcept
-        {
-            return timer > other.timer;
-        }
-    };
-
-    std::priority_queue<DeltaCursosPosElem, std::vector<DeltaCursosPosElem>, std::greater<DeltaCursosPosElem>>
-          deltasCursorPosBuffer;
-    float coyoteTimeCursorPos = 0.1f;
-    float releaseImpulse      = 3.f;
-    Vec2  deltaCursorAcc      = {0.f, 0.f};
-    Vec2  pixelPerMeter;
+    float prevCursorPosX     = 0;
+    float prevCursorPosY     = 0;
+    float deltaCursorPosX    = 0;
+    float deltaCursorPosY    = 0;
+    int   leftButtonEvent    = 0;
+    int   rightButtonEvent   = 0;
+    bool  isCursorControlled = false; // By the control socket, cursorPos isn't read from the window
+
+    // Global screen positions while the left button is pressed
+    CursorTracker cursorTracker;
+    float         coyoteTimeCursorPos = 0.1f; // Release velocity is estimated on this duration
+    float         releaseImpulse      = 3.f;
+    bool          immediateDrag       = true; // Move the grabbed pet from the cursor callback
+    Vec2          pixelPerMeter;
 
     // Settings
-    int   FPS        = 0;
-    int   scale      = 0;
-    float textScale  = 0;
-    int   randomSeed = 0;
+    int   FPS                  = 0;
+    int   scale                = 0;
+    float textScale            = 0;
+    int   randomSeed           = 0;
+    bool  parallelAssetLoading = true;
 
     // Physic
     int physicFrameRate = 60;
@@ -84,6 +80,7 @@ struct GameData
     float isGroundedDetection               = 0.f;
     int   footBasementWidth                 = 1;
     int   footBasementHeight                = 1;
+    bool  computeCollision                  = false; // Scan the edge mask with a compute shader
 
     // Time
     double timeAcc = 0.0;
@@ -94,6 +91,11 @@ struct GameData
     bool showFrameBufferBackground = false;
     bool useForwardWindow          = true;
     bool useMousePassThoughWindow  = true;
+    bool usePartialRedraw          = true;
+    bool headless                  = false; // Set from the command line, not saved
+
+    // Sprites blended by "OpenGL" or on the "CPU". "Auto" use the CPU with software OpenGL renderers.
+    std::string spriteRenderer = "Auto";
 
     // Style
     std::vector<std::filesystem::path> stylesPath;
@@ -101,4 +103,16 @@ struct GameData
 
     // Debug
     bool debugEdgeDetection = false;
+    bool showProfiler       = false; // Open the profiler menu at startup
+
+    // Prometheus metrics rewritten periodically, disabled if empty
+    std::string metricsFile;
+    float       metricsPeriod = 15.f; // In seconds
+
+    // Local socket to script the pets, disabled if empty
+    std::string controlSocketPath;
+
+    // GPU time of the passes and GL work of each frame, logged in the file if not empty
+    bool        GPUProfiling = false;
+    std::string GPUProfileFile;
 };
\ No newline at end of file
@@ -5,16 +5,11 @@
 #include "Engine/PhysicComponent.hpp"
 #include "Engine/SpriteAnimator.hpp"
 #include "Engine/SpriteSheet.hpp"
-#include "Engine/StateMachine.hpp"
 #include "Engine/UtilitySystem.hpp"
+#include "Game/AnimationGraph.hpp"
 #include "Game/DialoguePopUp.hpp"
 #include "Game/GameData.hpp"
 
-#include <map>
-#include <string>
-
-#include "yaml-cpp/yaml.h"
-
 class Pet : public Rect
 {
 public:
@@ -25,25 +20,18 @@ public:
     };
 
 protected:
-    std::map<std::string, SpriteSheet> spriteSheets;
-    ESide                              side{ESide::right};
+    ESide side{ESide::right};
 
     GameData& datas;
 
-    StateMachine   animator;
+    // Animation, the graph itself is shared by all the pets
+    AnimationState animationState;
     SpriteAnimator spriteAnimator;
-    int            indexCurrentAnimSprite = 0;
-    bool           loopCurrentAnim;
 
-    std::string   spritesPath = RESOURCE_PATH "/sprites/";
     DialoguePopUp dialoguePopup;
     UtilitySystem utilitySystem;
     NeedUpdator   needUpdator;
 
-    // Animation
-    std::shared_ptr<StateMachine::Node> firstNode;
-    std::shared_ptr<StateMachine::Node> pauseNode;
-
     bool isGrab = false;
     bool isPaused = false;
 
@@ -65,6 +53,8 @@ public:
     GETTER_BY_VALUE(IsPaused, isPaused)
     GETTER_BY_REF(PhysicComponent, physicComponent)
     GETTER_BY_REF(InteractionComponent, interactionComponent)
+    GETTER_BY_REF(AnimationState, animationState)
+    GETTER_BY_REF(SpriteAnimator, spriteAnimator)
 
     Pet(GameData& data);
 
@@ -72,34 +62,25 @@ public:
 
     void setIsPaused(bool flag);
 
+    // Mark the transitions depending on this event to be evaluated by the next animation graph update
+    void raiseAnimationEvent(AnimationState::EEvent event);
+
     void setPosition(const Vec2 position) override;
 
     void setPositionSize(const Vec2 position, const Vec2 size) override;
 
-    SpriteSheet& getOrAddSpriteSheet(const char* file, int inTileCount, float inSizeFactor);
-
-    void parseAnimationGraph();
-
     void setupUtilitySystem();
 
-    SpriteSheet& parseAnimation(YAML::Node node);
-
-    template <typename T>
-    bool AddBasicNode(YAML::Node node, std::map<std::string, std::shared_ptr<StateMachine::Node>>& nodes);
-
-    bool AddMovementNode(YAML::Node node, std::map<std::string, std::shared_ptr<StateMachine::Node>>& nodes);
-
-    bool AddJumpNode(YAML::Node node, std::map<std::string, std::shared_ptr<StateMachine::Node>>& nodes);
-
-    template <typename T>
-    bool AddBasicTransition(YAML::Node node, std::map<std::string, std::shared_ptr<StateMachine::Node>>& nodes);
-
-    bool AddRandomDelayTransition(YAML::Node node, std::map<std::string, std::shared_ptr<StateMachine::Node>>& nodes);
-
     void update(double deltaTime);
 
+    // Animation is stepped before by the animation graph
     void updateRendering(double deltaTime);
 
+    float getTimeBeforeNextAnimationFrame() const
+    {
+        return spriteAnimator.getTimeBeforeNextFrame();
+    }
+
     void draw();
 
     virtual bool isPointInside(Vec2 pointPos);
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "Engine/FrameStats.hpp"
+#include "Engine/Vector2.hpp"
+#include "Game/GameData.hpp"
+#include "Game/UIMenu.hpp"
+
+// Live view of the frame stats: frame time and stages graphs with their percentiles, allocations, draw calls, screen
+// capture bandwidth, cache hit rates and, if the GPU profiler is enabled, the GPU time of the passes
+class ProfilerMenu : public UIMenu
+{
+protected:
+    // Reused by each graph to avoid allocations in the measured frames
+    float m_values[FrameStats::s_historySize];
+    float m_sortedValues[FrameStats::s_historySize];
+
+protected:
+    // Sort a copy of the count first values
+    float computePercentile(size_t count, float percentile);
+
+    void plotHistory(const char* label, size_t count, const char* unit);
+
+public:
+    ProfilerMenu(GameData& inDatas, Vec2 inPosition);
+
+    void update(double deltaTime);
+};
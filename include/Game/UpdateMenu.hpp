@@ -9,7 +9,7 @@ class UpdateMenu : public UIMenu
 protected:
     std::string content;
     std::string changelog;
-    std::vector<std::string> lines;
+    std::vector<std::string> lines; // Of the changelog
     std::string windowName;
 
 protected:
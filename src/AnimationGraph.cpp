@@ -0,0 +1,414 @@
+#include "Game/AnimationGraph.hpp"
+
+#include "Engine/FrameStats.hpp"
+#include "Engine/Log.hpp"
+#include "Engine/Profiler.hpp"
+#include "Engine/TimeManager.hpp"
+#include "Engine/Utilities.hpp"
+#include "Game/Pet.hpp"
+
+#include <algorithm>
+
+AnimationGraph::AnimationGraph(const char* path)
+{
+    YAML::Node animGraph = YAML::LoadFile(path);
+
+    std::map<std::string, uint16_t> nodesIndex;
+    std::map<std::string, uint16_t> spriteSheetsIndex;
+
+    YAML::Node nodesSection = animGraph["Nodes"];
+    if (!nodesSection)
+        errorAndExit("Cannot find \"Nodes\" in animation.yaml");
+
+    for (YAML::const_iterator it = nodesSection.begin(); it != nodesSection.end(); ++it)
+    {
+        parseNode(it->first.Scalar(), it->second, nodesIndex, spriteSheetsIndex);
+    }
+
+    if (m_nodes.empty())
+        errorAndExit("No valid node in animation.yaml");
+
+    YAML::Node transitionsSection = animGraph["Transitions"];
+    if (!transitionsSection)
+        errorAndExit("Cannot find \"Transitions\" in animation.yaml");
+
+    // Transitions are declared in any order, group them by node so that a node only reads a contiguous range
+    std::vector<std::vector<Transition>> nodesTransitions(m_nodes.size());
+    for (YAML::const_iterator it = transitionsSection.begin(); it != transitionsSection.end(); ++it)
+    {
+        parseTransition(it->first.Scalar(), it->second, nodesIndex, nodesTransitions);
+    }
+
+    for (size_t i = 0; i < m_nodes.size(); ++i)
+    {
+        m_nodes[i].firstTransition = static_cast<uint16_t>(m_transitions.size());
+        m_nodes[i].transitionCount = static_cast<uint16_t>(nodesTransitions[i].size());
+        m_transitions.insert(m_transitions.end(), nodesTransitions[i].begin(), nodesTransitions[i].end());
+
+        for (const Transition& transition : nodesTransitions[i])
+        {
+            m_nodes[i].eventMask |= getConditionEvents(transition.condition);
+        }
+    }
+
+    // Optional Pause node
+    YAML::Node pauseNodeSetting = animGraph["PauseNode"];
+    if (pauseNodeSetting)
+    {
+        auto it = nodesIndex.find(pauseNodeSetting.as<std::string>());
+        if (it != nodesIndex.end())
+            m_pauseNode = it->second;
+    }
+
+    // First node
+    YAML::Node firstNodeSetting = animGraph["FirstNode"];
+    auto       firstNodeIt      = firstNodeSetting ? nodesIndex.find(firstNodeSetting.as<std::string>()) : nodesIndex.end();
+    if (firstNodeIt != nodesIndex.end())
+    {
+        m_firstNode = firstNodeIt->second;
+    }
+    else
+    {
+        m_firstNode = 0;
+        warning("FirstNode name is invalid. First node selected instead");
+    }
+}
+
+uint16_t AnimationGraph::parseSpriteSheet(YAML::Node node, std::map<std::string, uint16_t>& spriteSheetsIndex)
+{
+    const std::string file = node["sprite"].as<std::string>();
+
+    auto it = spriteSheetsIndex.find(file);
+    if (it != spriteSheetsIndex.end())
+        return it->second;
+
+    YAML::Node sizeFactorNode = node["sizeFactor"];
+    YAML::Node tileCountNode  = node["tileCount"];
+    m_spriteSheets.emplace_back(std::make_unique<SpriteSheet>(
+        (RESOURCE_PATH "/sprites/" + file).c_str(), tileCountNode.IsDefined() ? tileCountNode.as<int>() : 1,
+        sizeFactorNode.IsDefined() ? sizeFactorNode.as<float>() : 1.f));
+
+    const uint16_t index = static_cast<uint16_t>(m_spriteSheets.size() - 1);
+    spriteSheetsIndex.emplace(file, index);
+    return index;
+}
+
+bool AnimationGraph::parseNode(const std::string& type, YAML::Node node, std::map<std::string, uint16_t>& nodesIndex,
+                               std::map<std::string, uint16_t>& spriteSheetsIndex)
+{
+    if (!node.IsMap())
+    {
+        warning("YAML error: node invalid");
+        return false;
+    }
+
+    Node newNode;
+    if (type == "AnimationNode")
+    {
+        newNode.type = ENodeType::Animation;
+    }
+    else if (type == "GrabNode")
+    {
+        newNode.type = ENodeType::Grab;
+    }
+    else if (type == "MovementDirectionNode")
+    {
+        newNode.type         = ENodeType::MovementDirection;
+        newNode.applyGravity = node["applyGravity"].as<bool>();
+
+        newNode.firstDirection   = static_cast<uint16_t>(m_directions.size());
+        YAML::Node directionNode = node["directions"];
+        if (directionNode.IsSequence())
+        {
+            for (YAML::const_iterator it = directionNode.begin(); it != directionNode.end(); ++it)
+            {
+                m_directions.emplace_back(it->as<Vec2>());
+            }
+        }
+        else if (directionNode.IsScalar())
+        {
+            m_directions.emplace_back(directionNode.as<Vec2>());
+        }
+        newNode.directionCount = static_cast<uint16_t>(m_directions.size() - newNode.firstDirection);
+
+        if (newNode.directionCount == 0)
+        {
+            warning("YAML error: MovementDirectionNode without direction");
+            return false;
+        }
+    }
+    else if (type == "PetJumpNode")
+    {
+        newNode.type             = ENodeType::PetJump;
+        newNode.loop             = false;
+        newNode.firstDirection   = static_cast<uint16_t>(m_directions.size());
+        newNode.directionCount   = 1;
+        newNode.verticalThrust   = node["verticalThrust"].as<float>();
+        newNode.horizontalThrust = node["horizontalThrust"].as<float>();
+        m_directions.emplace_back(node["direction"].as<Vec2>());
+    }
+    else
+    {
+        warning(std::string("Node with name ") + type + " isn't implemented and is skiped");
+        return false;
+    }
+
+    if (newNode.type != ENodeType::PetJump)
+        newNode.loop = node["loop"].as<bool>();
+
+    newNode.frameRate   = node["framerate"].as<int>();
+    newNode.spriteSheet = parseSpriteSheet(node, spriteSheetsIndex);
+
+    nodesIndex.emplace(node["name"].as<std::string>(), static_cast<uint16_t>(m_nodes.size()));
+    m_nodes.emplace_back(newNode);
+    return true;
+}
+
+bool AnimationGraph::parseTransition(const std::string& type, YAML::Node node,
+                                     const std::map<std::string, uint16_t>& nodesIndex,
+                                     std::vector<std::vector<Transition>>& nodesTransitions)
+{
+    static const std::map<std::string, ECondition> s_conditions{
+        {"StartLeftClicTransition", ECondition::StartLeftClic},
+        {"EndLeftClicTransition", ECondition::EndLeftClic},
+        {"TouchScreenEdgeTransition", ECondition::TouchScreenEdge},
+        {"IsGroundedTransition", ECondition::IsGrounded},
+        {"IsNotGroundedTransition", ECondition::IsNotGrounded},
+        {"RandomDelayTransition", ECondition::RandomDelay},
+        {"AnimationEndTransition", ECondition::AnimationEnd}};
+
+    auto conditionIt = s_conditions.find(type);
+    if (conditionIt == s_conditions.end())
+    {
+        warning(std::string("Transition with name ") + type + " isn't implemented and is skiped");
+        return false;
+    }
+
+    const bool isRandomDelay = conditionIt->second == ECondition::RandomDelay;
+    if (!node.IsMap() || node.size() != (isRandomDelay ? 4 : 2))
+    {
+        warning("YAML error: transition invalid");
+        return false;
+    }
+
+    auto fromIt = nodesIndex.find(node["from"].as<std::string>());
+    if (fromIt == nodesIndex.end())
+    {
+        warning("YAML error: transition from an unknown node");
+        return false;
+    }
+
+    Transition transition;
+    transition.condition   = conditionIt->second;
+    transition.firstTarget = static_cast<uint16_t>(m_targets.size());
+
+    const auto addTarget = [&](const std::string& name) {
+        auto toIt = nodesIndex.find(name);
+        if (toIt != nodesIndex.end())
+            m_targets.emplace_back(toIt->second);
+        else
+            warning(std::string("YAML error: transition to the unknown node ") + name);
+    };
+
+    YAML::Node toNodes = node["to"];
+    if (toNodes.IsSequence())
+    {
+        for (YAML::const_iterator it = toNodes.begin(); it != toNodes.end(); ++it)
+        {
+            addTarget(it->as<std::string>());
+        }
+    }
+    else if (toNodes.IsScalar())
+    {
+        addTarget(toNodes.as<std::string>());
+    }
+
+    transition.targetCount = static_cast<uint16_t>(m_targets.size() - transition.firstTarget);
+    if (transition.targetCount == 0)
+        return false;
+
+    if (isRandomDelay)
+    {
+        transition.baseDelay_ms = node["duration"].as<int>();
+        transition.interval_ms  = node["interval"].as<int>();
+    }
+
+    nodesTransitions[fromIt->second].emplace_back(transition);
+    return true;
+}
+
+void AnimationGraph::enterNode(Pet& pet, uint16_t nodeIndex, GameData& datas) const
+{
+    const Node&     node  = m_nodes[nodeIndex];
+    AnimationState& state = pet.getAnimationState();
+
+    // State based transitions need to be evaluated once in the new node. Also cancel the previous node timer.
+    state               = AnimationState{};
+    state.node          = nodeIndex;
+    state.pendingEvents = AnimationState::Enter;
+    pet.getSpriteAnimator().play(datas, *m_spriteSheets[node.spriteSheet], node.loop, node.frameRate);
+
+    // Only the shortest delay can fire
+    float randomDelay = 0.f;
+    for (uint16_t i = node.firstTransition; i < node.firstTransition + node.transitionCount; ++i)
+    {
+        const Transition& transition = m_transitions[i];
+        if (transition.condition == ECondition::RandomDelay)
+        {
+            const float delay =
+                static_cast<float>(transition.baseDelay_ms + randNum(-transition.interval_ms, transition.interval_ms)) *
+                0.001f; // to seconde
+            if (state.randomDelayTransition == s_invalidIndex || delay < randomDelay)
+            {
+                state.randomDelayTransition = i;
+                randomDelay                 = delay;
+            }
+        }
+    }
+
+    if (state.randomDelayTransition != s_invalidIndex)
+    {
+        Pet* pPet              = &pet;
+        state.randomDelayTimer = TimeManager::instance().emplaceTimer(
+            [pPet]() { pPet->raiseAnimationEvent(AnimationState::Deadline); }, randomDelay);
+    }
+
+    switch (node.type)
+    {
+    case ENodeType::Grab:
+        pet.setIsGrab(true);
+        break;
+
+    case ENodeType::MovementDirection: {
+        state.direction         = static_cast<uint8_t>(randNum(0, node.directionCount - 1));
+        const Vec2       direction = m_directions[node.firstDirection + state.direction];
+        PhysicComponent& physic    = pet.getPhysicComponent();
+        pet.setSide((Pet::ESide)(direction.dot(Vec2::right()) > 0.f));
+        physic.applyGravity = node.applyGravity;
+        physic.continuousVelocity += direction;
+        break;
+    }
+
+    default:
+        break;
+    }
+}
+
+void AnimationGraph::exitNode(Pet& pet) const
+{
+    const AnimationState& state = pet.getAnimationState();
+    const Node&           node  = m_nodes[state.node];
+
+    switch (node.type)
+    {
+    case ENodeType::Grab:
+        pet.setIsGrab(false);
+        break;
+
+    case ENodeType::MovementDirection: {
+        PhysicComponent& physic = pet.getPhysicComponent();
+        physic.applyGravity     = true;
+        physic.continuousVelocity -= m_directions[node.firstDirection + state.direction];
+        break;
+    }
+
+    default:
+        break;
+    }
+}
+
+bool AnimationGraph::isConditionMet(const Transition& transition, uint16_t transitionIndex, Pet& pet,
+                                    GameData& datas) const
+{
+    const AnimationState&       state  = pet.getAnimationState();
+    const PhysicComponent&      physic = pet.getPhysicComponent();
+    const InteractionComponent& input  = pet.getInteractionComponent();
+
+    // Only called if one of the condition events is pending
+    switch (transition.condition)
+    {
+    case ECondition::StartLeftClic:
+        return true;
+
+    case ECondition::EndLeftClic:
+        return !input.isLeftSelected;
+
+    case ECondition::TouchScreenEdge:
+        return physic.touchScreenEdge;
+
+    case ECondition::IsGrounded:
+        return physic.isGrounded;
+
+    case ECondition::IsNotGrounded:
+        return !physic.isGrounded;
+
+    case ECondition::RandomDelay:
+        return state.randomDelayTransition == transitionIndex;
+
+    case ECondition::AnimationEnd:
+        return pet.getSpriteAnimator().isDone();
+    }
+    return false;
+}
+
+void AnimationGraph::start(Pet& pet, GameData& datas) const
+{
+    enterNode(pet, m_firstNode, datas);
+}
+
+void AnimationGraph::setPaused(Pet& pet, bool isPaused, GameData& datas) const
+{
+    if (isPaused && m_pauseNode == s_invalidIndex)
+        return;
+
+    exitNode(pet);
+    enterNode(pet, isPaused ? m_pauseNode : m_firstNode, datas);
+}
+
+void AnimationGraph::update(const std::vector<std::shared_ptr<Pet>>& pets, GameData& datas, double deltaTime) const
+{
+    PROFILE_SCOPE("AnimationGraph::update");
+    FrameStageTimer stageTimer(EFrameStage::Animation);
+
+    for (const std::shared_ptr<Pet>& pPet : pets)
+    {
+        Pet&            pet            = *pPet;
+        AnimationState& state          = pet.getAnimationState();
+        const Node&     node           = m_nodes[state.node];
+        SpriteAnimator& spriteAnimator = pet.getSpriteAnimator();
+
+        const bool wasAnimationDone = spriteAnimator.isDone();
+        spriteAnimator.update(datas, deltaTime);
+        if (!wasAnimationDone && spriteAnimator.isDone())
+            state.pendingEvents |= AnimationState::AnimationEnd;
+
+        // Jump begin when the jump animation is done, the node is then left by its animation end transition
+        if (node.type == ENodeType::PetJump && spriteAnimator.isDone())
+        {
+            PhysicComponent& physic = pet.getPhysicComponent();
+            physic.velocity += m_directions[node.firstDirection] * ((int)pet.getSide() * 2.f - 1.f) *
+                                   node.horizontalThrust -
+                               datas.gravity * node.verticalThrust;
+            physic.isGrounded = false;
+        }
+
+        if (pet.getIsPaused())
+            continue;
+
+        const uint8_t events = state.pendingEvents & node.eventMask;
+        state.pendingEvents  = 0;
+        if (events == 0)
+            continue;
+
+        for (uint16_t i = node.firstTransition; i < node.firstTransition + node.transitionCount; ++i)
+        {
+            const Transition& transition = m_transitions[i];
+            if ((events & getConditionEvents(transition.condition)) && isConditionMet(transition, i, pet, datas))
+            {
+                exitNode(pet);
+                enterNode(pet, m_targets[transition.firstTarget + randNum(0, transition.targetCount - 1)], datas);
+                break;
+            }
+        }
+    }
+}
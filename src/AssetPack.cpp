@@ -0,0 +1,164 @@
+#include "Engine/AssetPack.hpp"
+
+#include "Engine/Log.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+
+#if defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__NT__)
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+AssetPack::~AssetPack()
+{
+    close();
+}
+
+bool AssetPack::open(const char* path)
+{
+    close();
+
+#if defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__NT__)
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER fileSize;
+    HANDLE        mapping = GetFileSizeEx(file, &fileSize) ? CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL)
+                                                           : NULL;
+    const void*   view    = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (view == nullptr)
+    {
+        if (mapping)
+            CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    m_fileHandle    = file;
+    m_mappingHandle = mapping;
+    m_size          = static_cast<size_t>(fileSize.QuadPart);
+    m_data          = static_cast<const unsigned char*>(view);
+#else
+    int file = ::open(path, O_RDONLY);
+    if (file < 0)
+        return false;
+
+    struct stat fileStat;
+    void*       view = fstat(file, &fileStat) == 0 && fileStat.st_size > 0
+                           ? mmap(nullptr, fileStat.st_size, PROT_READ, MAP_PRIVATE, file, 0)
+                           : MAP_FAILED;
+    // Mapping stay valid after closing the file descriptor
+    ::close(file);
+    if (view == MAP_FAILED)
+        return false;
+
+    m_mappingHandle = view;
+    m_size          = static_cast<size_t>(fileStat.st_size);
+    m_data          = static_cast<const unsigned char*>(view);
+#endif
+
+    const AssetPackFormat::Header* header  = reinterpret_cast<const AssetPackFormat::Header*>(m_data);
+    const AssetPackFormat::Entry*  entries = reinterpret_cast<const AssetPackFormat::Entry*>(header + 1);
+    if (m_size < sizeof(AssetPackFormat::Header) || header->magic != AssetPackFormat::magic ||
+        header->version != AssetPackFormat::version ||
+        m_size < sizeof(AssetPackFormat::Header) + header->entryCount * sizeof(AssetPackFormat::Entry) ||
+        !std::is_sorted(entries, entries + header->entryCount, isPathLess))
+    {
+        logf("Asset pack \"%s\" is invalid and is ignored\n", path);
+        close();
+        return false;
+    }
+
+    m_header  = header;
+    m_entries = entries;
+    logf("Asset pack \"%s\" opened with %u images\n", path, m_header->entryCount);
+    return true;
+}
+
+void AssetPack::close()
+{
+    if (m_data == nullptr)
+        return;
+
+#if defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__NT__)
+    UnmapViewOfFile(m_data);
+    CloseHandle(m_mappingHandle);
+    CloseHandle(m_fileHandle);
+#else
+    munmap(m_mappingHandle, m_size);
+#endif
+
+    m_data          = nullptr;
+    m_size          = 0;
+    m_header        = nullptr;
+    m_entries       = nullptr;
+    m_fileHandle    = nullptr;
+    m_mappingHandle = nullptr;
+}
+
+bool AssetPack::isPathLess(const AssetPackFormat::Entry& lhs, const AssetPackFormat::Entry& rhs)
+{
+    return strncmp(lhs.path, rhs.path, sizeof(lhs.path)) < 0;
+}
+
+bool AssetPack::isEntryUpToDate(const AssetPackFormat::Entry& entry, const std::string& sourcePath) const
+{
+    // Only a stat, the file is not read
+    std::error_code error;
+    const uintmax_t sourceSize = std::filesystem::file_size(sourcePath, error);
+
+    // Loose file was removed, the pack is the only source
+    if (error)
+        return true;
+
+    return sourceSize == entry.sourceSize;
+}
+
+bool AssetPack::find(const std::string& path, bool verticalFlip, Image& image) const
+{
+    if (!isOpen())
+        return false;
+
+    constexpr size_t prefixLength = sizeof(RESOURCE_PATH "/") - 1;
+    if (path.compare(0, prefixLength, RESOURCE_PATH "/") != 0)
+        return false;
+
+    const char* relativePath = path.c_str() + prefixLength;
+    const auto  isEntryLess  = [](const AssetPackFormat::Entry& entry, const char* key) {
+        return strncmp(entry.path, key, sizeof(entry.path)) < 0;
+    };
+    const AssetPackFormat::Entry* entriesEnd = m_entries + m_header->entryCount;
+    const AssetPackFormat::Entry* it         = std::lower_bound(m_entries, entriesEnd, relativePath, isEntryLess);
+    if (it != entriesEnd && strncmp(it->path, relativePath, sizeof(it->path)) == 0)
+    {
+        const AssetPackFormat::Entry& entry      = *it;
+        const bool                    isFlipped  = entry.flags & AssetPackFormat::VerticalFlip;
+        const uint64_t                pixelCount = static_cast<uint64_t>(entry.width) * entry.height;
+
+        // Texture upload and collisions read width * height * channels bytes from the mapping
+        const bool isValid = entry.channels >= 1 && entry.channels <= 4 &&
+                             entry.pixelsSize == pixelCount * entry.channels &&
+                             (entry.opacityMaskSize == 0 || entry.opacityMaskSize == (pixelCount + 7) / 8) &&
+                             entry.pixelsOffset + entry.pixelsSize <= m_size &&
+                             entry.opacityMaskOffset + entry.opacityMaskSize <= m_size;
+        if (isFlipped == verticalFlip && isValid && isEntryUpToDate(entry, path))
+        {
+            image.pixels      = m_data + entry.pixelsOffset;
+            image.opacityMask = entry.opacityMaskSize ? m_data + entry.opacityMaskOffset : nullptr;
+            image.width       = static_cast<int>(entry.width);
+            image.height      = static_cast<int>(entry.height);
+            image.channels    = static_cast<int>(entry.channels);
+            m_hitCount.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    m_missCount.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
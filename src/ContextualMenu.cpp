@@ -3,13 +3,15 @@
 #include "Engine/FileExplorer.hpp"
 #include "Engine/ImGuiTools.hpp"
 #include "Engine/InteractionSystem.hpp"
+#include "Engine/TimeManager.hpp"
 
 #include "Game/Pet.hpp"
+#include "Game/ProfilerMenu.hpp"
 #include "Game/SettingMenu.hpp"
 #include "imgui.h"
 
 #include <cpr/cpr.h>
-#include <format>
+#include <cstdio>
 
 ContextualMenu::ContextualMenu(GameData& inDatas, Pet& inPet, Vec2 inPosition)
     : UIMenu(inDatas, inPosition, Vec2(100.f, 150.f)), pet{inPet}
@@ -70,9 +72,16 @@ void ContextualMenu::update(double deltaTime)
         shouldClose = true;
     }
 
+    if (ImGui::Button("Profiler", sizeButton))
+    {
+        datas.profilerMenu = nullptr; // delete previous window
+        datas.profilerMenu = std::make_unique<ProfilerMenu>(datas, getPosition());
+        shouldClose        = true;
+    }
+
     // Next content at the end of the window
     ImGui::SetCursorPosY(ImGui::GetCursorPosY() + ImGui::GetContentRegionAvail().y -
-                         ImGui::GetTextLineHeightWithSpacing() * 5 - ImGui::GetStyle().FramePadding.y * 5 - 1);
+                         ImGui::GetTextLineHeightWithSpacing() * 7 - ImGui::GetStyle().FramePadding.y * 5 - 1);
     ImGui::Separator();
 
     float  imageRatio = ImGui::GetTextLineHeight() / datas.pDiscordLogo->getHeight();
@@ -104,9 +113,21 @@ void ContextualMenu::update(double deltaTime)
         exit(0);
     }
 
-    std::string txt = std::format("{:.1f} FPS", ImGui::GetIO().Framerate);
-    ImGui::SetNextTextLayout(txt.c_str(), 0.5, 0);
-    ImGui::Text(txt.c_str());
+    // Formatted on the stack, the menu is drawn each frame
+    char txt[64];
+    snprintf(txt, sizeof(txt), "%.1f FPS", ImGui::GetIO().Framerate);
+    ImGui::SetNextTextLayout(txt, 0.5, 0);
+    ImGui::TextUnformatted(txt);
+
+    snprintf(txt, sizeof(txt), "%.0f wakeups/s %.1f%% CPU", TimeManager::instance().getWakeUpsPerSecond(),
+             TimeManager::instance().getCPUUsage());
+    ImGui::SetNextTextLayout(txt, 0.5, 0);
+    ImGui::TextUnformatted(txt);
+
+    snprintf(txt, sizeof(txt), "Drag latency %.1f ms (max %.1f)", TimeManager::instance().getInputLatency_ms(),
+             TimeManager::instance().getMaxInputLatency_ms());
+    ImGui::SetNextTextLayout(txt, 0.5, 0);
+    ImGui::TextUnformatted(txt);
     windowEnd();
     ImGui::End();
 }
@@ -0,0 +1,265 @@
+#include "Engine/ControlSocket.hpp"
+
+#include "Engine/Log.hpp"
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <afunix.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+
+namespace
+{
+#ifdef _WIN32
+constexpr uintptr_t s_invalidSocket = INVALID_SOCKET;
+constexpr int       s_sendFlags     = 0;
+
+bool isWouldBlockError()
+{
+    return WSAGetLastError() == WSAEWOULDBLOCK;
+}
+
+void closeSocket(uintptr_t socket)
+{
+    closesocket(static_cast<SOCKET>(socket));
+}
+
+bool setNonBlocking(uintptr_t socket)
+{
+    u_long mode = 1;
+    return ioctlsocket(static_cast<SOCKET>(socket), FIONBIO, &mode) == 0;
+}
+#else
+constexpr int s_invalidSocket = -1;
+#ifdef MSG_NOSIGNAL
+constexpr int s_sendFlags = MSG_NOSIGNAL; // A closed client must not kill the process with SIGPIPE
+#else
+constexpr int s_sendFlags = 0;
+#endif
+
+bool isWouldBlockError()
+{
+    return errno == EAGAIN || errno == EWOULDBLOCK;
+}
+
+void closeSocket(int socket)
+{
+    ::close(socket);
+}
+
+bool setNonBlocking(int socket)
+{
+    const int flags = fcntl(socket, F_GETFL, 0);
+    return flags != -1 && fcntl(socket, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+#endif
+} // namespace
+
+ControlSocket::ControlSocket() : m_listenSocket{s_invalidSocket}
+{
+}
+
+ControlSocket::~ControlSocket()
+{
+    close();
+}
+
+bool ControlSocket::open(const std::string& path)
+{
+    close();
+
+#ifdef _WIN32
+    static const bool isWinsockStarted = []() {
+        WSADATA data;
+        return WSAStartup(MAKEWORD(2, 2), &data) == 0;
+    }();
+    if (!isWinsockStarted)
+        return false;
+#endif
+
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path))
+    {
+        logf(ELogLevel::Warning, "Control socket path \"%s\" is too long\n", path.c_str());
+        return false;
+    }
+    memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+    // Left by a previous run
+    std::error_code error;
+    std::filesystem::remove(path, error);
+
+    m_listenSocket = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (m_listenSocket == s_invalidSocket)
+    {
+        logf(ELogLevel::Warning, "Cannot create the control socket\n");
+        return false;
+    }
+
+    if (!setNonBlocking(m_listenSocket) ||
+        bind(m_listenSocket, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(m_listenSocket, static_cast<int>(s_maxClientCount)) != 0)
+    {
+        logf(ELogLevel::Warning, "Cannot listen on the control socket \"%s\"\n", path.c_str());
+        closeSocket(m_listenSocket);
+        m_listenSocket = s_invalidSocket;
+        return false;
+    }
+
+    m_path = path;
+    logf("Control socket listening on \"%s\"\n", path.c_str());
+    return true;
+}
+
+void ControlSocket::close()
+{
+    for (Client& client : m_clients)
+    {
+        closeSocket(client.socket);
+    }
+    m_clients.clear();
+
+    if (m_listenSocket != s_invalidSocket)
+    {
+        closeSocket(m_listenSocket);
+        m_listenSocket = s_invalidSocket;
+
+        std::error_code error;
+        std::filesystem::remove(m_path, error);
+    }
+}
+
+bool ControlSocket::isOpen() const noexcept
+{
+    return m_listenSocket != s_invalidSocket;
+}
+
+void ControlSocket::receive(Client& client, const RequestHandler& handler)
+{
+    char buffer[4096];
+    while (true)
+    {
+        const auto size = recv(client.socket, buffer, static_cast<int>(sizeof(buffer)), 0);
+        if (size > 0)
+        {
+            client.input.append(buffer, static_cast<size_t>(size));
+            continue;
+        }
+
+        // 0 if the client closed the connection
+        if (size == 0 || !isWouldBlockError())
+            client.isClosed = true;
+        break;
+    }
+
+    size_t lineBegin = 0;
+    for (size_t lineEnd = client.input.find('\n'); lineEnd != std::string::npos;
+         lineEnd        = client.input.find('\n', lineBegin))
+    {
+        size_t requestEnd = lineEnd;
+        if (requestEnd > lineBegin && client.input[requestEnd - 1] == '\r')
+            --requestEnd;
+
+        if (requestEnd > lineBegin)
+        {
+            m_response.clear();
+            handler(client.input.substr(lineBegin, requestEnd - lineBegin), m_response);
+            client.output += m_response;
+            client.output += '\n';
+        }
+        lineBegin = lineEnd + 1;
+    }
+    client.input.erase(0, lineBegin);
+
+    if (client.input.size() > s_maxLineSize)
+    {
+        logf(ELogLevel::Warning, "Control socket request longer than %zu bytes, client disconnected\n",
+             s_maxLineSize);
+        client.isClosed = true;
+    }
+}
+
+void ControlSocket::send(Client& client)
+{
+    size_t sentSize = 0;
+    while (sentSize < client.output.size())
+    {
+        const auto size = ::send(client.socket, client.output.data() + sentSize,
+                                 static_cast<int>(client.output.size() - sentSize), s_sendFlags);
+        if (size <= 0)
+        {
+            if (size < 0 && !isWouldBlockError())
+                client.isClosed = true;
+            break;
+        }
+        sentSize += static_cast<size_t>(size);
+    }
+    client.output.erase(0, sentSize);
+}
+
+void ControlSocket::poll(const RequestHandler& handler)
+{
+    if (!isOpen())
+        return;
+
+    while (m_clients.size() < s_maxClientCount)
+    {
+        const SocketHandle clientSocket = accept(m_listenSocket, nullptr, nullptr);
+        if (clientSocket == s_invalidSocket)
+            break;
+
+        if (!setNonBlocking(clientSocket))
+        {
+            closeSocket(clientSocket);
+            continue;
+        }
+        m_clients.push_back({clientSocket});
+    }
+
+    for (Client& client : m_clients)
+    {
+        receive(client, handler);
+        send(client);
+
+        if (client.isClosed)
+            closeSocket(client.socket);
+    }
+
+    const auto isClosed = [](const Client& client) { return client.isClosed; };
+    m_clients.erase(std::remove_if(m_clients.begin(), m_clients.end(), isClosed), m_clients.end());
+}
+
+void ControlSocket::appendJSONString(std::string& out, const char* text)
+{
+    out += '"';
+    for (const char* c = text; *c != '\0'; ++c)
+    {
+        switch (*c)
+        {
+        case '"':
+            out += "\\\"";
+            break;
+        case '\\':
+            out += "\\\\";
+            break;
+        case '\n':
+            out += "\\n";
+            break;
+        default:
+            if (static_cast<unsigned char>(*c) >= 0x20)
+                out += *c;
+            break;
+        }
+    }
+    out += '"';
+}
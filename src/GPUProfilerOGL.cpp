@@ -0,0 +1,194 @@
+#include "Engine/Graphics/GPUProfilerOGL.hpp"
+
+#include "Engine/Graphics/GLStateOGL.hpp"
+#include "Engine/Log.hpp"
+
+#include <glad/glad.h>
+
+GPUProfiler::~GPUProfiler()
+{
+    // Queries are deleted by stop, they can't be deleted once the context is destroyed
+    if (m_CSVFile)
+        fclose(m_CSVFile);
+}
+
+void GPUProfiler::start(const char* CSVPath)
+{
+    stop();
+
+    if (CSVPath && CSVPath[0] != '\0')
+    {
+        m_CSVFile = fopen(CSVPath, "w");
+        if (m_CSVFile)
+        {
+            fprintf(m_CSVFile, "frame,cpu_ms,draw_calls,state_changes,uploads,upload_bytes,readback_bytes");
+            for (const char* passName : s_passNames)
+                fprintf(m_CSVFile, ",gpu_%s_ms", passName);
+            fprintf(m_CSVFile, "\n");
+        }
+        else
+        {
+            logf(ELogLevel::Warning, "Cannot open the GPU profile file \"%s\"\n", CSVPath);
+        }
+    }
+
+    m_isEnabled          = true;
+    m_hasDebugGroups     = GLAD_GL_VERSION_4_3;
+    m_frameCount         = 0;
+    m_nextPendingFrame   = 0;
+    m_droppedFrameCount  = 0;
+    m_resolvedFrameCount = 0;
+    m_currentFrame       = Frame{};
+    m_stateChangeStart   = GLState::instance().getCallCount() - GLState::instance().getElidedCallCount();
+}
+
+void GPUProfiler::stop()
+{
+    if (!m_isEnabled)
+        return;
+
+    // Pending results are dropped
+    for (PendingFrame& pendingFrame : m_pendingFrames)
+    {
+        for (const Query& query : pendingFrame.queries)
+            m_freeQueries.emplace_back(query.ID);
+        pendingFrame.queries.clear();
+    }
+    if (!m_freeQueries.empty())
+        glDeleteQueries(static_cast<GLsizei>(m_freeQueries.size()), m_freeQueries.data());
+    m_freeQueries.clear();
+
+    if (m_CSVFile)
+    {
+        fclose(m_CSVFile);
+        m_CSVFile = nullptr;
+    }
+
+    m_isEnabled = false;
+    m_timedPass = EGPUPass::COUNT;
+}
+
+bool GPUProfiler::beginPass(EGPUPass pass)
+{
+    if (m_hasDebugGroups)
+        glPushDebugGroup(GL_DEBUG_SOURCE_APPLICATION, 0, -1, s_passNames[static_cast<size_t>(pass)]);
+
+    // The time of a nested pass is counted in its parent
+    if (m_timedPass != EGPUPass::COUNT)
+        return false;
+
+    unsigned int queryID;
+    if (m_freeQueries.empty())
+    {
+        glGenQueries(1, &queryID);
+    }
+    else
+    {
+        queryID = m_freeQueries.back();
+        m_freeQueries.pop_back();
+    }
+
+    glBeginQuery(GL_TIME_ELAPSED, queryID);
+    m_pendingFrames[m_frameCount % s_latency].queries.push_back({queryID, pass});
+    m_timedPass = pass;
+    return true;
+}
+
+void GPUProfiler::endPass(bool isTimed)
+{
+    if (isTimed)
+    {
+        glEndQuery(GL_TIME_ELAPSED);
+        m_timedPass = EGPUPass::COUNT;
+    }
+
+    if (m_hasDebugGroups)
+        glPopDebugGroup();
+}
+
+bool GPUProfiler::isAvailable(const PendingFrame& pendingFrame) const
+{
+    for (const Query& query : pendingFrame.queries)
+    {
+        GLuint isQueryAvailable = GL_FALSE;
+        glGetQueryObjectuiv(query.ID, GL_QUERY_RESULT_AVAILABLE, &isQueryAvailable);
+        if (isQueryAvailable == GL_FALSE)
+            return false;
+    }
+    return true;
+}
+
+void GPUProfiler::resolve(PendingFrame& pendingFrame)
+{
+    // Available, reading the results doesn't wait
+    for (const Query& query : pendingFrame.queries)
+    {
+        GLuint64 elapsed_ns = 0;
+        glGetQueryObjectui64v(query.ID, GL_QUERY_RESULT, &elapsed_ns);
+        pendingFrame.frame.passes_ms[static_cast<size_t>(query.pass)] += static_cast<float>(elapsed_ns / 1000000.);
+        m_freeQueries.emplace_back(query.ID);
+    }
+    pendingFrame.queries.clear();
+
+    m_history[m_resolvedFrameCount % s_historySize] = pendingFrame.frame;
+    ++m_resolvedFrameCount;
+
+    if (m_CSVFile)
+        writeCSVLine(pendingFrame);
+}
+
+void GPUProfiler::drop(PendingFrame& pendingFrame)
+{
+    // Still in flight, a query can be restarted before its result is read: the previous result is discarded
+    for (const Query& query : pendingFrame.queries)
+        m_freeQueries.emplace_back(query.ID);
+    pendingFrame.queries.clear();
+    ++m_droppedFrameCount;
+}
+
+void GPUProfiler::writeCSVLine(const PendingFrame& pendingFrame)
+{
+    const Frame&             frame    = pendingFrame.frame;
+    const FrameStats::Frame& CPUFrame = pendingFrame.CPUFrame;
+
+    fprintf(m_CSVFile, "%zu,%.3f,%u,%u,%u,%llu,%llu", pendingFrame.index, CPUFrame.total_ms,
+            CPUFrame.drawCallCount, frame.stateChangeCount, frame.uploadCount,
+            static_cast<unsigned long long>(frame.uploadBytes), static_cast<unsigned long long>(frame.readbackBytes));
+    for (const float pass_ms : frame.passes_ms)
+        fprintf(m_CSVFile, ",%.3f", pass_ms);
+    fprintf(m_CSVFile, "\n");
+}
+
+void GPUProfiler::endFrame()
+{
+    if (!m_isEnabled)
+        return;
+
+    const uint64_t stateChangeCount = GLState::instance().getCallCount() - GLState::instance().getElidedCallCount();
+    m_currentFrame.stateChangeCount = static_cast<uint32_t>(stateChangeCount - m_stateChangeStart);
+    m_stateChangeStart              = stateChangeCount;
+
+    const FrameStats& frameStats = FrameStats::instance();
+    PendingFrame&     submitted  = m_pendingFrames[m_frameCount % s_latency];
+    submitted.frame              = m_currentFrame;
+    submitted.CPUFrame           = frameStats.getFrame(frameStats.getHistoryCount() - 1);
+    submitted.index              = m_frameCount;
+    ++m_frameCount;
+    m_currentFrame = Frame{};
+
+    // In order, from the oldest frame in flight
+    for (; m_nextPendingFrame < m_frameCount; ++m_nextPendingFrame)
+    {
+        PendingFrame& pendingFrame = m_pendingFrames[m_nextPendingFrame % s_latency];
+        if (!isAvailable(pendingFrame))
+            break;
+        resolve(pendingFrame);
+    }
+
+    // Slot of the next frame still in flight
+    if (m_frameCount - m_nextPendingFrame >= s_latency)
+    {
+        drop(m_pendingFrames[m_nextPendingFrame % s_latency]);
+        ++m_nextPendingFrame;
+    }
+}
@@ -0,0 +1,172 @@
+#include "Engine/ImageLoader.hpp"
+
+#include "Engine/AssetPack.hpp"
+#include "Engine/Log.hpp"
+#include "Engine/Profiler.hpp"
+
+#include "stb_image.h"
+
+#include <fstream>
+#include <memory>
+
+ImageLoader::~ImageLoader()
+{
+    stop();
+}
+
+void ImageLoader::start(unsigned int workerCount)
+{
+    m_shouldStop = false;
+    for (unsigned int i = 0; i < workerCount; ++i)
+    {
+        m_workers.emplace_back(&ImageLoader::workerLoop, this);
+    }
+}
+
+void ImageLoader::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_shouldStop = true;
+    }
+    m_condition.notify_all();
+
+    for (std::thread& worker : m_workers)
+    {
+        worker.join();
+    }
+    m_workers.clear();
+
+    // Free images requested but never taken
+    for (auto& [key, pendingImage] : m_pendingImages)
+    {
+        Image image = pendingImage.get();
+        if (image.isOwned)
+            stbi_image_free(image.data);
+    }
+    m_pendingImages.clear();
+    m_pendingFiles.clear();
+    m_tasks.clear();
+}
+
+void ImageLoader::workerLoop()
+{
+    PROFILE_THREAD("Image loader");
+
+    while (true)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [&]() { return m_shouldStop || !m_tasks.empty(); });
+
+            if (m_tasks.empty())
+                return;
+
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+        }
+        task();
+    }
+}
+
+void ImageLoader::pushTask(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tasks.emplace_back(std::move(task));
+    }
+    m_condition.notify_one();
+}
+
+ImageLoader::Image ImageLoader::decode(const char* path, bool verticalFlip)
+{
+    PROFILE_SCOPE("Decode image");
+
+    Image image;
+    // Flag is thread local, workers can decode images with different orientations
+    stbi_set_flip_vertically_on_load_thread(verticalFlip);
+    image.data = stbi_load(path, &image.width, &image.height, &image.channels, 0);
+
+    if (image.data == nullptr)
+        logf("Failed to decode image \"%s\": %s\n", path, stbi_failure_reason());
+
+    return image;
+}
+
+ImageLoader::Image ImageLoader::load(const char* path, bool verticalFlip)
+{
+    AssetPack::Image packedImage;
+    if (!AssetPack::instance().find(path, verticalFlip, packedImage))
+        return decode(path, verticalFlip);
+
+    Image image;
+    image.data        = const_cast<unsigned char*>(packedImage.pixels);
+    image.opacityMask = packedImage.opacityMask;
+    image.width       = packedImage.width;
+    image.height      = packedImage.height;
+    image.channels    = packedImage.channels;
+    image.isOwned     = false;
+    return image;
+}
+
+std::vector<char> ImageLoader::readFile(const char* path)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file)
+    {
+        logf("The file '%s' was not opened\n", path);
+        return {};
+    }
+
+    std::vector<char> content(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(content.data(), content.size());
+    return content;
+}
+
+void ImageLoader::requestImage(const std::string& path, bool verticalFlip)
+{
+    if (m_workers.empty())
+        return;
+
+    const std::string key = imageKey(path, verticalFlip);
+    if (m_pendingImages.contains(key))
+        return;
+
+    auto promise = std::make_shared<std::promise<Image>>();
+    m_pendingImages.emplace(key, promise->get_future());
+    pushTask([promise, path, verticalFlip]() { promise->set_value(load(path.c_str(), verticalFlip)); });
+}
+
+void ImageLoader::requestFile(const std::string& path)
+{
+    if (m_workers.empty() || m_pendingFiles.contains(path))
+        return;
+
+    auto promise = std::make_shared<std::promise<std::vector<char>>>();
+    m_pendingFiles.emplace(path, promise->get_future());
+    pushTask([promise, path]() { promise->set_value(readFile(path.c_str())); });
+}
+
+ImageLoader::Image ImageLoader::takeImage(const std::string& path, bool verticalFlip)
+{
+    auto it = m_pendingImages.find(imageKey(path, verticalFlip));
+    if (it == m_pendingImages.end())
+        return load(path.c_str(), verticalFlip);
+
+    Image image = it->second.get();
+    m_pendingImages.erase(it);
+    return image;
+}
+
+std::vector<char> ImageLoader::takeFile(const std::string& path)
+{
+    auto it = m_pendingFiles.find(path);
+    if (it == m_pendingFiles.end())
+        return readFile(path.c_str());
+
+    std::vector<char> content = it->second.get();
+    m_pendingFiles.erase(it);
+    return content;
+}
@@ -0,0 +1,658 @@
+#include "Engine/Logger.hpp"
+
+#include "Engine/Profiler.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+
+namespace
+{
+enum class EArgType : uint8_t
+{
+    None, // %% or unsupported conversion, written as is
+    Int,
+    UInt,
+    Double,
+    String,
+    Pointer
+};
+
+enum class ELength : uint8_t
+{
+    None,
+    Long,
+    LongLong,
+    Size,
+    Max,
+    Ptrdiff,
+    LongDouble
+};
+
+struct FormatSpec
+{
+    const char* begin       = nullptr; // On the '%'
+    const char* lengthBegin = nullptr; // After the flags, width and precision
+    const char* end         = nullptr; // After the conversion
+    int         starCount   = 0;       // Width and precision given as int arguments before the value
+    ELength     length      = ELength::None;
+    EArgType    type        = EArgType::None;
+    char        conversion  = '\0';
+};
+
+FormatSpec parseSpec(const char* percent)
+{
+    FormatSpec spec;
+    spec.begin         = percent;
+    const char* cursor = percent + 1;
+
+    while (*cursor != '\0' && strchr("-+ #0", *cursor) != nullptr)
+        ++cursor;
+
+    if (*cursor == '*')
+    {
+        ++spec.starCount;
+        ++cursor;
+    }
+    while (isdigit(static_cast<unsigned char>(*cursor)))
+        ++cursor;
+
+    if (*cursor == '.')
+    {
+        ++cursor;
+        if (*cursor == '*')
+        {
+            ++spec.starCount;
+            ++cursor;
+        }
+        while (isdigit(static_cast<unsigned char>(*cursor)))
+            ++cursor;
+    }
+
+    spec.lengthBegin = cursor;
+    while (*cursor != '\0' && strchr("hlLzjt", *cursor) != nullptr)
+    {
+        switch (*cursor)
+        {
+        case 'l':
+            spec.length = spec.length == ELength::Long ? ELength::LongLong : ELength::Long;
+            break;
+        case 'L':
+            spec.length = ELength::LongDouble;
+            break;
+        case 'z':
+            spec.length = ELength::Size;
+            break;
+        case 'j':
+            spec.length = ELength::Max;
+            break;
+        case 't':
+            spec.length = ELength::Ptrdiff;
+            break;
+        default: // Promoted to int
+            break;
+        }
+        ++cursor;
+    }
+
+    spec.conversion = *cursor;
+    if (*cursor != '\0')
+        ++cursor;
+    spec.end = cursor;
+
+    switch (spec.conversion)
+    {
+    case 'd':
+    case 'i':
+    case 'c':
+        spec.type = EArgType::Int;
+        break;
+    case 'u':
+    case 'o':
+    case 'x':
+    case 'X':
+        spec.type = EArgType::UInt;
+        break;
+    case 'f':
+    case 'F':
+    case 'e':
+    case 'E':
+    case 'g':
+    case 'G':
+    case 'a':
+    case 'A':
+        spec.type = EArgType::Double;
+        break;
+    case 's':
+        spec.type = EArgType::String;
+        break;
+    case 'p':
+        spec.type = EArgType::Pointer;
+        break;
+    default:
+        spec.type = EArgType::None;
+        break;
+    }
+    return spec;
+}
+
+template <typename T>
+bool pushArgument(unsigned char* buffer, size_t capacity, size_t& size, T value)
+{
+    if (size + sizeof(T) > capacity)
+        return false;
+    memcpy(buffer + size, &value, sizeof(T));
+    size += sizeof(T);
+    return true;
+}
+
+template <typename T>
+bool popArgument(const unsigned char* buffer, size_t size, size_t& offset, T& value)
+{
+    if (offset + sizeof(T) > size)
+        return false;
+    memcpy(&value, buffer + offset, sizeof(T));
+    offset += sizeof(T);
+    return true;
+}
+
+// Integers and pointers are stored on 64 bits, floating points as double and strings as their 16 bits size followed
+// by their characters (truncated to the remaining space). Stop at the first argument which doesn't fit.
+uint16_t encodeArguments(const char* format, va_list args, unsigned char* buffer, size_t capacity)
+{
+    va_list argsCopy;
+    va_copy(argsCopy, args);
+
+    size_t size = 0;
+    for (const char* cursor = strchr(format, '%'); cursor != nullptr; cursor = strchr(cursor, '%'))
+    {
+        const FormatSpec spec = parseSpec(cursor);
+        cursor                = spec.end;
+
+        bool isStored = true;
+        for (int i = 0; i < spec.starCount && isStored; ++i)
+            isStored = pushArgument<int64_t>(buffer, capacity, size, va_arg(argsCopy, int));
+
+        switch (spec.type)
+        {
+        case EArgType::Int: {
+            int64_t value;
+            switch (spec.length)
+            {
+            case ELength::Long:
+                value = va_arg(argsCopy, long);
+                break;
+            case ELength::LongLong:
+                value = va_arg(argsCopy, long long);
+                break;
+            case ELength::Size:
+                value = static_cast<int64_t>(va_arg(argsCopy, size_t));
+                break;
+            case ELength::Max:
+                value = va_arg(argsCopy, intmax_t);
+                break;
+            case ELength::Ptrdiff:
+                value = va_arg(argsCopy, ptrdiff_t);
+                break;
+            default:
+                value = va_arg(argsCopy, int);
+                break;
+            }
+            isStored = isStored && pushArgument(buffer, capacity, size, value);
+            break;
+        }
+        case EArgType::UInt: {
+            uint64_t value;
+            switch (spec.length)
+            {
+            case ELength::Long:
+                value = va_arg(argsCopy, unsigned long);
+                break;
+            case ELength::LongLong:
+                value = va_arg(argsCopy, unsigned long long);
+                break;
+            case ELength::Size:
+                value = va_arg(argsCopy, size_t);
+                break;
+            case ELength::Max:
+                value = va_arg(argsCopy, uintmax_t);
+                break;
+            case ELength::Ptrdiff:
+                value = static_cast<uint64_t>(va_arg(argsCopy, ptrdiff_t));
+                break;
+            default:
+                value = va_arg(argsCopy, unsigned int);
+                break;
+            }
+            isStored = isStored && pushArgument(buffer, capacity, size, value);
+            break;
+        }
+        case EArgType::Double: {
+            const double value = spec.length == ELength::LongDouble
+                                     ? static_cast<double>(va_arg(argsCopy, long double))
+                                     : va_arg(argsCopy, double);
+            isStored           = isStored && pushArgument(buffer, capacity, size, value);
+            break;
+        }
+        case EArgType::Pointer: {
+            const uint64_t value = reinterpret_cast<uintptr_t>(va_arg(argsCopy, void*));
+            isStored             = isStored && pushArgument(buffer, capacity, size, value);
+            break;
+        }
+        case EArgType::String: {
+            const char* value = va_arg(argsCopy, const char*);
+            if (value == nullptr)
+                value = "(null)";
+
+            if (!isStored || size + sizeof(uint16_t) >= capacity)
+            {
+                isStored = false;
+                break;
+            }
+            const uint16_t length = static_cast<uint16_t>(strnlen(value, capacity - size - sizeof(uint16_t)));
+            pushArgument(buffer, capacity, size, length);
+            memcpy(buffer + size, value, length);
+            size += length;
+            break;
+        }
+        default:
+            break;
+        }
+
+        if (!isStored)
+            break;
+    }
+
+    va_end(argsCopy);
+    return static_cast<uint16_t>(size);
+}
+
+// Format with the stored arguments, a conversion without its argument ends the text with "..."
+size_t formatRecord(const Logger::Record& record, char* text, size_t capacity)
+{
+    size_t size   = 0;
+    size_t offset = 0;
+
+    const auto append = [&](const char* str, size_t count) {
+        count = std::min(count, capacity - 1 - size);
+        memcpy(text + size, str, count);
+        size += count;
+    };
+
+    for (const char* cursor = record.format; *cursor != '\0' && size < capacity - 1;)
+    {
+        if (*cursor != '%')
+        {
+            const char* next = strchr(cursor, '%');
+            if (next == nullptr)
+                next = cursor + strlen(cursor);
+            append(cursor, next - cursor);
+            cursor = next;
+            continue;
+        }
+
+        const FormatSpec spec = parseSpec(cursor);
+        cursor                = spec.end;
+
+        if (spec.conversion == '%')
+        {
+            append("%", 1);
+            continue;
+        }
+
+        // Unknown and too long conversions are written as is
+        if (spec.type == EArgType::None || spec.lengthBegin - spec.begin > 16)
+        {
+            append(spec.begin, spec.end - spec.begin);
+            continue;
+        }
+
+        // Rebuild the conversion for the stored type: '*' replaced by their value and integers on 64 bits
+        char conversion[64];
+        int  conversionSize = 0;
+        bool isComplete     = true;
+        for (const char* c = spec.begin; c < spec.lengthBegin && isComplete; ++c)
+        {
+            int64_t starValue;
+            if (*c != '*')
+                conversion[conversionSize++] = *c;
+            else if ((isComplete = popArgument(record.args, record.argsSize, offset, starValue)))
+                conversionSize += snprintf(conversion + conversionSize, 16, "%d", static_cast<int>(starValue));
+        }
+        if ((spec.type == EArgType::Int || spec.type == EArgType::UInt) && spec.conversion != 'c')
+        {
+            conversion[conversionSize++] = 'l';
+            conversion[conversionSize++] = 'l';
+        }
+        conversion[conversionSize++] = spec.conversion;
+        conversion[conversionSize]   = '\0';
+
+        int written = 0;
+        switch (spec.type)
+        {
+        case EArgType::Int: {
+            int64_t value;
+            if ((isComplete = isComplete && popArgument(record.args, record.argsSize, offset, value)))
+                written = spec.conversion == 'c'
+                              ? snprintf(text + size, capacity - size, conversion, static_cast<int>(value))
+                              : snprintf(text + size, capacity - size, conversion, static_cast<long long>(value));
+            break;
+        }
+        case EArgType::UInt: {
+            uint64_t value;
+            if ((isComplete = isComplete && popArgument(record.args, record.argsSize, offset, value)))
+                written = snprintf(text + size, capacity - size, conversion, static_cast<unsigned long long>(value));
+            break;
+        }
+        case EArgType::Double: {
+            double value;
+            if ((isComplete = isComplete && popArgument(record.args, record.argsSize, offset, value)))
+                written = snprintf(text + size, capacity - size, conversion, value);
+            break;
+        }
+        case EArgType::Pointer: {
+            uint64_t value;
+            if ((isComplete = isComplete && popArgument(record.args, record.argsSize, offset, value)))
+                written = snprintf(text + size, capacity - size, conversion,
+                                   reinterpret_cast<void*>(static_cast<uintptr_t>(value)));
+            break;
+        }
+        case EArgType::String: {
+            uint16_t length;
+            if ((isComplete = isComplete && popArgument(record.args, record.argsSize, offset, length)))
+            {
+                char value[Logger::s_recordSize];
+                memcpy(value, record.args + offset, length);
+                value[length] = '\0';
+                offset += length;
+                written = snprintf(text + size, capacity - size, conversion, value);
+            }
+            break;
+        }
+        default:
+            break;
+        }
+
+        if (!isComplete)
+        {
+            append("...", 3);
+            break;
+        }
+        size += std::min(static_cast<size_t>(std::max(written, 0)), capacity - 1 - size);
+    }
+
+    text[size] = '\0';
+    return size;
+}
+} // namespace
+
+Logger::Logger()
+{
+    m_flusher = std::thread(&Logger::flushLoop, this);
+}
+
+Logger::~Logger()
+{
+    // Messages of other threads logged from now are written synchronously
+    s_isDestroyed.store(true, std::memory_order_release);
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_shouldStop = true;
+    }
+    m_condition.notify_one();
+    m_flusher.join();
+
+    if (m_file != nullptr)
+        fclose(m_file);
+}
+
+std::filesystem::path Logger::getLogDirectory()
+{
+#if defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__NT__)
+    if (const char* localAppData = std::getenv("LOCALAPPDATA"))
+        return std::filesystem::path(localAppData) / PROJECT_NAME / "Logs";
+#else
+    if (const char* xdgState = std::getenv("XDG_STATE_HOME"))
+        return std::filesystem::path(xdgState) / PROJECT_NAME;
+    if (const char* home = std::getenv("HOME"))
+        return std::filesystem::path(home) / ".local" / "state" / PROJECT_NAME;
+#endif
+    return std::filesystem::temp_directory_path() / PROJECT_NAME;
+}
+
+ELogLevel Logger::parseLevel(const std::string& name, ELogLevel defaultLevel)
+{
+    for (size_t i = 0; i < static_cast<size_t>(ELogLevel::COUNT); ++i)
+    {
+        if (name == s_levelNames[i])
+            return static_cast<ELogLevel>(i);
+    }
+    return defaultLevel;
+}
+
+Logger::ThreadBuffer* Logger::registerThread()
+{
+    std::lock_guard<std::mutex> lock(m_threadBuffersMutex);
+    return m_threadBuffers.emplace_back(std::make_unique<ThreadBuffer>()).get();
+}
+
+bool Logger::isRateLimited(ThreadBuffer& buffer, uint64_t key, int64_t time_ns, uint32_t& suppressedCount)
+{
+    RateLimit& limit = buffer.rateLimits[(key >> 3) & (ThreadBuffer::s_rateLimitCount - 1)];
+
+    // One second window, the messages suppressed in the previous one are reported with the next message
+    if (limit.key != key || time_ns - limit.windowStart_ns >= 1000000000)
+    {
+        suppressedCount = limit.key == key ? limit.suppressedCount : 0;
+        limit           = {key, time_ns, 0, 0};
+    }
+
+    if (limit.count >= s_maxMessagesPerSecond)
+    {
+        ++limit.suppressedCount;
+        return true;
+    }
+    ++limit.count;
+    return false;
+}
+
+void Logger::writeText(ELogLevel level, const char* format, ...)
+{
+    if (level < getMinLevel())
+        return;
+
+    va_list args;
+    va_start(args, format);
+
+    va_list textArgs;
+    va_copy(textArgs, args);
+    const char* text = va_arg(textArgs, const char*);
+    va_end(textArgs);
+
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ull;
+    for (const char* c = text; *c != '\0'; ++c)
+    {
+        hash ^= static_cast<unsigned char>(*c);
+        hash *= 1099511628211ull;
+    }
+
+    write(level, hash, format, args);
+    va_end(args);
+}
+
+void Logger::write(ELogLevel level, uint64_t rateLimitKey, const char* format, va_list args)
+{
+    if (level < getMinLevel())
+        return;
+
+    const int64_t time_ns         = getTime_ns();
+    ThreadBuffer& buffer          = getThreadBuffer();
+    uint32_t      suppressedCount = 0;
+    // Errors are often the last message before an exit, they must not be dropped
+    if (level < ELogLevel::Error && isRateLimited(buffer, rateLimitKey, time_ns, suppressedCount))
+        return;
+
+    const uint64_t writeCount = buffer.writeCount.load(std::memory_order_relaxed);
+    if (writeCount - buffer.readCount.load(std::memory_order_acquire) >= s_ringCapacity)
+    {
+        buffer.droppedCount.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    Record& record         = buffer.records[writeCount & (s_ringCapacity - 1)];
+    record.time_ns         = time_ns;
+    record.format          = format;
+    record.suppressedCount = suppressedCount;
+    record.level           = level;
+    record.argsSize        = encodeArguments(format, args, record.args, sizeof(record.args));
+    buffer.writeCount.store(writeCount + 1, std::memory_order_release);
+
+    // Only the first record since the last flush wakes the flusher. The mutex is taken so that the notification can't
+    // happen between the check of the flusher and its wait.
+    if (!m_isFlushRequested.exchange(true, std::memory_order_acq_rel))
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+        }
+        m_condition.notify_one();
+    }
+}
+
+void Logger::flushLoop()
+{
+    PROFILE_THREAD("Logger");
+
+    openFile();
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_shouldStop)
+    {
+        m_condition.wait_for(lock, s_flushTimeout, [this] {
+            return m_shouldStop || m_isFlushRequested.load(std::memory_order_relaxed);
+        });
+        // Before the flush: records written during it request the next one. Synchronize with the write requests.
+        m_isFlushRequested.exchange(false, std::memory_order_acq_rel);
+
+        lock.unlock();
+        flush();
+        lock.lock();
+    }
+    lock.unlock();
+    flush();
+}
+
+void Logger::flush()
+{
+    std::lock_guard<std::mutex> lock(m_threadBuffersMutex);
+
+    // Merge the rings by time
+    while (true)
+    {
+        ThreadBuffer* oldestBuffer = nullptr;
+        const Record* oldestRecord = nullptr;
+        for (const std::unique_ptr<ThreadBuffer>& buffer : m_threadBuffers)
+        {
+            const uint64_t readCount = buffer->readCount.load(std::memory_order_relaxed);
+            if (readCount == buffer->writeCount.load(std::memory_order_acquire))
+                continue;
+
+            const Record& record = buffer->records[readCount & (s_ringCapacity - 1)];
+            if (oldestRecord == nullptr || record.time_ns < oldestRecord->time_ns)
+            {
+                oldestBuffer = buffer.get();
+                oldestRecord = &record;
+            }
+        }
+
+        if (oldestBuffer == nullptr)
+            break;
+
+        writeRecord(*oldestRecord);
+        oldestBuffer->readCount.fetch_add(1, std::memory_order_release);
+    }
+
+    for (const std::unique_ptr<ThreadBuffer>& buffer : m_threadBuffers)
+    {
+        if (const uint32_t droppedCount = buffer->droppedCount.exchange(0, std::memory_order_relaxed))
+        {
+            char text[64];
+            const int size = snprintf(text, sizeof(text), "%u messages dropped, log ring full\n", droppedCount);
+            writeLine(ELogLevel::Warning, getTime_ns(), text, size);
+        }
+    }
+
+    if (m_file != nullptr)
+        fflush(m_file);
+}
+
+void Logger::writeRecord(const Record& record)
+{
+    char text[2048];
+    if (record.suppressedCount != 0)
+    {
+        const int size = snprintf(text, sizeof(text), "%u similar messages suppressed\n", record.suppressedCount);
+        writeLine(record.level, record.time_ns, text, size);
+    }
+
+    const size_t size = formatRecord(record, text, sizeof(text));
+    writeLine(record.level, record.time_ns, text, size);
+}
+
+void Logger::writeLine(ELogLevel level, int64_t time_ns, const char* text, size_t size)
+{
+    char prefix[32];
+    const int prefixSize = snprintf(prefix, sizeof(prefix), "[%10.3f] [%c] ", time_ns / 1e9,
+                                    s_levelNames[static_cast<size_t>(level)][0]);
+    const bool hasNewLine = size != 0 && text[size - 1] == '\n';
+
+    fwrite(prefix, 1, prefixSize, stderr);
+    fwrite(text, 1, size, stderr);
+    if (!hasNewLine)
+        fputc('\n', stderr);
+
+    if (m_file == nullptr)
+        return;
+
+    fwrite(prefix, 1, prefixSize, m_file);
+    fwrite(text, 1, size, m_file);
+    if (!hasNewLine)
+        fputc('\n', m_file);
+
+    m_fileSize += prefixSize + size + !hasNewLine;
+    if (m_fileSize > s_maxFileSize)
+        openFile();
+}
+
+void Logger::openFile()
+{
+    if (m_file != nullptr)
+    {
+        fclose(m_file);
+        m_file = nullptr;
+    }
+    m_fileSize = 0;
+
+    std::error_code error;
+    if (m_filePath.empty())
+    {
+        const std::filesystem::path directory = getLogDirectory();
+        std::filesystem::create_directories(directory, error);
+        m_filePath = directory / PROJECT_NAME ".log";
+    }
+
+    // PROJECT_NAME.log become PROJECT_NAME.1.log... and the oldest is removed
+    const auto getRotatedPath = [&](int index) {
+        return m_filePath.parent_path() / (PROJECT_NAME "." + std::to_string(index) + ".log");
+    };
+    for (int i = s_rotatedFileCount; i > 0; --i)
+    {
+        std::filesystem::rename(i == 1 ? m_filePath : getRotatedPath(i - 1), getRotatedPath(i), error);
+    }
+
+    m_file = fopen(m_filePath.string().c_str(), "w");
+    if (m_file == nullptr)
+        fprintf(stderr, "Cannot open the log file \"%s\"\n", m_filePath.string().c_str());
+}
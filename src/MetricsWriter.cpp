@@ -0,0 +1,77 @@
+#include "Engine/MetricsWriter.hpp"
+
+#include "Engine/Log.hpp"
+
+#include <cstdio>
+
+void MetricsWriter::addHeader(const char* name, const char* help, const char* type)
+{
+    m_text += "# HELP ";
+    m_text += name;
+    m_text += ' ';
+    m_text += help;
+    m_text += "\n# TYPE ";
+    m_text += name;
+    m_text += ' ';
+    m_text += type;
+    m_text += '\n';
+}
+
+void MetricsWriter::addGauge(const char* name, const char* help, double value)
+{
+    char line[128];
+    snprintf(line, sizeof(line), "%s %.17g\n", name, value);
+    addHeader(name, help, "gauge");
+    m_text += line;
+}
+
+void MetricsWriter::addCounter(const char* name, const char* help, double value)
+{
+    char line[128];
+    snprintf(line, sizeof(line), "%s %.17g\n", name, value);
+    addHeader(name, help, "counter");
+    m_text += line;
+}
+
+void MetricsWriter::addHistogram(const char* name, const char* help, const double* bounds,
+                                 const uint64_t* bucketCounts, size_t bucketCount, uint64_t count, double sum)
+{
+    char line[160];
+    addHeader(name, help, "histogram");
+    for (size_t i = 0; i < bucketCount; ++i)
+    {
+        snprintf(line, sizeof(line), "%s_bucket{le=\"%g\"} %llu\n", name, bounds[i],
+                 static_cast<unsigned long long>(bucketCounts[i]));
+        m_text += line;
+    }
+    snprintf(line, sizeof(line), "%s_bucket{le=\"+Inf\"} %llu\n%s_sum %.17g\n%s_count %llu\n", name,
+             static_cast<unsigned long long>(count), name, sum, name, static_cast<unsigned long long>(count));
+    m_text += line;
+}
+
+bool MetricsWriter::writeFile(const std::filesystem::path& path)
+{
+    std::filesystem::path temporaryPath = path;
+    temporaryPath += ".tmp";
+
+    FILE* file = fopen(temporaryPath.string().c_str(), "wb");
+    if (file == nullptr)
+    {
+        logf(ELogLevel::Warning, "Cannot write the metrics file \"%s\"\n", temporaryPath.string().c_str());
+        m_text.clear();
+        return false;
+    }
+    fwrite(m_text.data(), 1, m_text.size(), file);
+    fclose(file);
+    m_text.clear();
+
+    std::error_code error;
+    std::filesystem::rename(temporaryPath, path, error);
+    if (error)
+    {
+        logf(ELogLevel::Warning, "Cannot replace the metrics file \"%s\": %s\n", path.string().c_str(),
+             error.message().c_str());
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,78 @@
+#include "Engine/Graphics/PostProcessOGL.hpp"
+
+#include "Engine/Log.hpp"
+
+#include "yaml-cpp/yaml.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+PostProcess::PostProcess(Window& window, const char* path)
+{
+    YAML::Node passesSection = YAML::LoadFile(path)["Passes"];
+    if (!passesSection)
+        errorAndExit(std::string("Cannot find \"Passes\" in ") + path);
+
+    for (YAML::const_iterator it = passesSection.begin(); it != passesSection.end(); ++it)
+    {
+        const std::string fragmentPath =
+            std::string(SHADER_RESOURCE_PATH "/") + (*it)["Shader"].as<std::string>() + SHADER_FRAG_EXT;
+
+        Pass& pass  = m_passes.emplace_back();
+        pass.shader = std::make_unique<Shader>(window, SHADER_RESOURCE_PATH "/image" SHADER_VERTEX_EXT,
+                                               fragmentPath.c_str());
+        pass.uTexture    = pass.shader->getUniform<UniformSampler>("uTexture");
+        pass.uResolution = pass.shader->getUniform<UniformVec2>("uResolution");
+        pass.scale       = std::clamp((*it)["Scale"].as<float>(1.f), 0.01f, 1.f);
+    }
+
+    if (m_passes.empty())
+        errorAndExit(std::string("No pass in ") + path);
+
+    if (m_passes.back().scale != 1.f)
+    {
+        warning("The last pass writes the output, its scale is ignored");
+        m_passes.back().scale = 1.f;
+    }
+}
+
+const Texture& PostProcess::getTarget(size_t passIndex, const Texture& input)
+{
+    const float scale  = m_passes[passIndex].scale;
+    const int   width  = std::max(static_cast<int>(std::round(input.getWidth() * scale)), 1);
+    const int   height = std::max(static_cast<int>(std::round(input.getHeight() * scale)), 1);
+
+    std::unique_ptr<Texture>& target = m_targets[passIndex % 2];
+    if (!target)
+    {
+        // Linear to upsample the downscaled passes, same than nearest at the same size
+        target = std::make_unique<Texture>(width, height, 4, Texture::linearClampSampling);
+    }
+    target->resize(width, height);
+    return *target;
+}
+
+void PostProcess::apply(Framebuffer& framebuffer, ScreenSpaceQuad& quad, const Texture& input, const Texture& output)
+{
+    framebuffer.bind();
+    quad.use();
+
+    const Texture* source = &input;
+    for (size_t i = 0; i < m_passes.size(); ++i)
+    {
+        const Texture& target = i + 1 == m_passes.size() ? output : getTarget(i, input);
+        framebuffer.attachTexture(target);
+        GLState::instance().viewport(0, 0, target.getWidth(), target.getHeight());
+
+        const Pass& pass = m_passes[i];
+        pass.shader->use();
+        pass.shader->set(pass.uTexture, 0);
+        pass.shader->set(pass.uResolution, static_cast<float>(source->getWidth()),
+                         static_cast<float>(source->getHeight()));
+        source->use();
+        quad.draw();
+
+        source = &target;
+    }
+}
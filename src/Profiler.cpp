@@ -0,0 +1,50 @@
+#include "Engine/Profiler.hpp"
+
+#ifdef USE_PROFILER
+
+#include "Engine/Log.hpp"
+
+#include <fstream>
+
+bool Profiler::saveChromeTrace(const char* path)
+{
+    std::ofstream file(path);
+    if (!file)
+    {
+        logf("The file \"%s\" was not opened to write\n", path);
+        return false;
+    }
+
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    file << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"" PROJECT_NAME "\"}}";
+
+    std::lock_guard<std::mutex> lock(m_threadBuffersMutex);
+    size_t                      zoneCount = 0;
+    for (const std::unique_ptr<ThreadBuffer>& buffer : m_threadBuffers)
+    {
+        // Zones of other threads can be overwritten while copied if their buffer is full. It only affects the oldest.
+        const uint64_t count = buffer->zoneCount.load(std::memory_order_acquire);
+        const uint64_t first = count > ThreadBuffer::s_capacity ? count - ThreadBuffer::s_capacity : 0;
+
+        file << ",{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->threadIndex
+             << ",\"args\":{\"name\":\"" << buffer->threadName << "\"}}";
+
+        char event[256];
+        for (uint64_t i = first; i < count; ++i)
+        {
+            const Zone& zone = buffer->zones[i & (ThreadBuffer::s_capacity - 1)];
+
+            // Timestamps in microseconds
+            snprintf(event, sizeof(event), ",{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                     zone.name, buffer->threadIndex, zone.begin_ns / 1000., (zone.end_ns - zone.begin_ns) / 1000.);
+            file << event;
+        }
+        zoneCount += count - first;
+    }
+    file << "]}\n";
+
+    logf("Profiler trace saved in \"%s\" (%zu zones)\n", path, zoneCount);
+    return true;
+}
+
+#endif // USE_PROFILER
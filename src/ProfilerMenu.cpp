@@ -0,0 +1,172 @@
+#include "Game/ProfilerMenu.hpp"
+
+#include "Engine/AssetPack.hpp"
+#include "Engine/Profiler.hpp"
+
+#ifdef USE_OPENGL_API
+#include "Engine/Graphics/GLStateOGL.hpp"
+#include "Engine/Graphics/GPUProfilerOGL.hpp"
+#include "Engine/Graphics/ShaderCacheOGL.hpp"
+#endif // USE_OPENGL_API
+
+#include "imgui.h"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace
+{
+float computeHitRate(int hitCount, int missCount)
+{
+    const int total = hitCount + missCount;
+    return total == 0 ? 0.f : hitCount * 100.f / total;
+}
+} // namespace
+
+ProfilerMenu::ProfilerMenu(GameData& inDatas, Vec2 inPosition) : UIMenu(inDatas, inPosition, Vec2(280.f, 420.f))
+{
+}
+
+float ProfilerMenu::computePercentile(size_t count, float percentile)
+{
+    if (count == 0)
+        return 0.f;
+
+    std::copy(m_values, m_values + count, m_sortedValues);
+    const size_t index = std::min(static_cast<size_t>(percentile * count), count - 1);
+    std::nth_element(m_sortedValues, m_sortedValues + index, m_sortedValues + count);
+    return m_sortedValues[index];
+}
+
+void ProfilerMenu::plotHistory(const char* label, size_t count, const char* unit)
+{
+    const float p50 = computePercentile(count, 0.5f);
+    const float p99 = computePercentile(count, 0.99f);
+
+    char overlay[64];
+    snprintf(overlay, sizeof(overlay), "p50 %.2f%s p99 %.2f%s", p50, unit, p99, unit);
+
+    // Scale on the p99 so that a single spike doesn't flatten the graph
+    ImGui::PlotLines(label, m_values, static_cast<int>(count), 0, overlay, 0.f, std::max(p99 * 1.2f, 0.001f),
+                     ImVec2(ImGui::GetContentRegionAvail().x * 0.6f, ImGui::GetTextLineHeight() * 2.5f));
+}
+
+void ProfilerMenu::update(double deltaTime)
+{
+    windowBegin();
+
+    bool isWindowOpen = true;
+    ImGui::Begin("Profiler", &isWindowOpen, ImGuiWindowFlags_NoCollapse);
+    shouldClose = !isWindowOpen;
+
+    const FrameStats& stats = FrameStats::instance();
+    const size_t      count = stats.getHistoryCount();
+
+    if (count != 0)
+    {
+        const FrameStats::Frame& lastFrame = stats.getFrame(count - 1);
+        ImGui::Text("%zu frames, last %.2f ms", count, lastFrame.total_ms);
+    }
+
+    for (size_t i = 0; i < count; ++i)
+        m_values[i] = stats.getFrame(i).total_ms;
+    plotHistory("Frame", count, "ms");
+
+    if (ImGui::CollapsingHeader("Stages", ImGuiTreeNodeFlags_DefaultOpen))
+    {
+        for (size_t stage = 0; stage < static_cast<size_t>(EFrameStage::COUNT); ++stage)
+        {
+            for (size_t i = 0; i < count; ++i)
+                m_values[i] = stats.getFrame(i).stages_ms[stage];
+            plotHistory(FrameStats::s_stageNames[stage], count, "ms");
+        }
+    }
+
+    if (ImGui::CollapsingHeader("Frame content", ImGuiTreeNodeFlags_DefaultOpen))
+    {
+        for (size_t i = 0; i < count; ++i)
+            m_values[i] = static_cast<float>(stats.getFrame(i).allocationCount);
+        plotHistory("Allocations", count, "");
+
+        for (size_t i = 0; i < count; ++i)
+            m_values[i] = static_cast<float>(stats.getFrame(i).drawCallCount);
+        plotHistory("Draw calls", count, "");
+
+        for (size_t i = 0; i < count; ++i)
+            m_values[i] = stats.getFrame(i).captureBytes / 1024.f;
+        plotHistory("Capture", count, "KB");
+    }
+
+    if (ImGui::CollapsingHeader("Caches", ImGuiTreeNodeFlags_DefaultOpen))
+    {
+        const AssetPack& assetPack = AssetPack::instance();
+        ImGui::Text("Asset pack: %.0f%% hit (%d hits, %d misses)",
+                    computeHitRate(assetPack.getHitCount(), assetPack.getMissCount()), assetPack.getHitCount(),
+                    assetPack.getMissCount());
+
+#ifdef USE_OPENGL_API
+        const ShaderCache& shaderCache = ShaderCache::instance();
+        ImGui::Text("Shader cache: %.0f%% hit (%d hits, %d misses)",
+                    computeHitRate(shaderCache.getHitCount(), shaderCache.getMissCount()), shaderCache.getHitCount(),
+                    shaderCache.getMissCount());
+
+        const GLState& state = GLState::instance();
+        ImGui::Text("GL state: %.0f%% elided (%llu of %llu calls)",
+                    state.getCallCount() ? 100. * state.getElidedCallCount() / state.getCallCount() : 0.,
+                    static_cast<unsigned long long>(state.getElidedCallCount()),
+                    static_cast<unsigned long long>(state.getCallCount()));
+#endif // USE_OPENGL_API
+    }
+
+#ifdef USE_OPENGL_API
+    const GPUProfiler& GPUStats = GPUProfiler::instance();
+    if (GPUStats.isEnabled() && ImGui::CollapsingHeader("GPU", ImGuiTreeNodeFlags_DefaultOpen))
+    {
+        // Resolved a few frames late, the history is shorter than the CPU one
+        const size_t GPUCount = GPUStats.getHistoryCount();
+
+        for (size_t i = 0; i < GPUCount; ++i)
+        {
+            m_values[i] = 0.f;
+            for (const float pass_ms : GPUStats.getFrame(i).passes_ms)
+                m_values[i] += pass_ms;
+        }
+        const float GPUTotal_ms = computePercentile(GPUCount, 0.5f);
+        plotHistory("GPU frame", GPUCount, "ms");
+
+        for (size_t i = 0; i < count; ++i)
+            m_values[i] = stats.getFrame(i).total_ms;
+        const float CPUTotal_ms = computePercentile(count, 0.5f);
+        ImGui::Text("p50 GPU %.2f ms, CPU %.2f ms: %s bound", GPUTotal_ms, CPUTotal_ms,
+                    GPUTotal_ms > CPUTotal_ms ? "GPU" : "CPU");
+        ImGui::Text("%zu frames dropped, results not available in time", GPUStats.getDroppedFrameCount());
+
+        for (size_t pass = 0; pass < static_cast<size_t>(EGPUPass::COUNT); ++pass)
+        {
+            for (size_t i = 0; i < GPUCount; ++i)
+                m_values[i] = GPUStats.getFrame(i).passes_ms[pass];
+            plotHistory(GPUProfiler::s_passNames[pass], GPUCount, "ms");
+        }
+
+        for (size_t i = 0; i < GPUCount; ++i)
+            m_values[i] = static_cast<float>(GPUStats.getFrame(i).stateChangeCount);
+        plotHistory("State changes", GPUCount, "");
+
+        for (size_t i = 0; i < GPUCount; ++i)
+            m_values[i] = GPUStats.getFrame(i).uploadBytes / 1024.f;
+        plotHistory("Uploads", GPUCount, "KB");
+
+        for (size_t i = 0; i < GPUCount; ++i)
+            m_values[i] = GPUStats.getFrame(i).readbackBytes / 1024.f;
+        plotHistory("Readbacks", GPUCount, "KB");
+    }
+#endif // USE_OPENGL_API
+
+#ifdef USE_PROFILER
+    if (ImGui::Button("Save trace", ImVec2(ImGui::GetContentRegionAvail().x, 0.0f)))
+        Profiler::instance().saveChromeTrace("profiler_trace.json");
+#endif // USE_PROFILER
+
+    windowEnd();
+    ImGui::End();
+}
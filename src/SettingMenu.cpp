@@ -48,6 +48,8 @@ void SettingMenu::update(double deltaTime)
                 ImGui::EndCombo();
             }
 
+            ImGui::Checkbox("Immediate drag", &datas.immediateDrag);
+
             ImGui::EndTabItem();
         }
 
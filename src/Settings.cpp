@@ -13,21 +13,50 @@ void Setting::importFile(const char* src, GameData& data)
         errorAndExit(std::string("Could not find setting file here: ") + src);
     }
 
+    importNode(root, data);
+}
+
+void Setting::importValues(const YAML::Node& values, GameData& data)
+{
+    YAML::Emitter out;
+    emit(out, data);
+
+    YAML::Node root = YAML::Load(out.c_str());
+    for (YAML::Node section : root)
+    {
+        for (YAML::iterator sectionIter = section.begin(); sectionIter != section.end(); sectionIter++)
+        {
+            const YAML::Node sectionValues = values[sectionIter->first.as<std::string>()];
+            if (!sectionValues)
+                continue;
+
+            for (YAML::const_iterator valueIter = sectionValues.begin(); valueIter != sectionValues.end(); valueIter++)
+            {
+                sectionIter->second[valueIter->first.as<std::string>()] = valueIter->second;
+            }
+        }
+    }
+    importNode(root, data);
+}
+
+void Setting::importNode(const YAML::Node& root, GameData& data)
+{
     YAML::Node  nodesSection;
     for (auto roleIter = root.begin(); roleIter != root.end(); roleIter++)
     {
         nodesSection = (*roleIter)["Game"];
         if (nodesSection)
         {
-            data.FPS        = std::max(nodesSection["FPS"].as<int>(), 1);
-            data.randomSeed = nodesSection["RandomSeed"].as<int>();
+            data.FPS                  = std::max(nodesSection["FPS"].as<int>(), 1);
+            data.randomSeed           = nodesSection["RandomSeed"].as<int>();
+            data.parallelAssetLoading = nodesSection["ParallelAssetLoading"].as<bool>(true);
             continue;
         }
 
         nodesSection = (*roleIter)["Physic"];
         if (nodesSection)
         {
-            data.physicFrameRate = std::max(nodesSection["PhysicFrameRate"].as<int>(), 0);
+            data.physicFrameRate = std::max(nodesSection["PhysicFrameRate"].as<int>(), 1);
             data.bounciness      = std::clamp(nodesSection["Bounciness"].as<float>(), 0.f, 1.f);
             data.gravity         = Vec2{nodesSection["GravityX"].as<float>(), nodesSection["GravityY"].as<float>()};
             data.gravityDir      = data.gravity.normalized();
@@ -41,6 +70,7 @@ void Setting::importFile(const char* src, GameData& data)
                 std::clamp(nodesSection["CollisionPixelRatioStopMovement"].as<float>(), 0.f, 1.f);
             data.isGroundedDetection = std::max(nodesSection["IsGroundedDetection"].as<float>(), 0.f);
             data.releaseImpulse      = std::max(nodesSection["InputReleaseImpulse"].as<float>(), 0.f);
+            data.computeCollision    = nodesSection["ComputeCollision"].as<bool>(false);
             continue;
         }
 
@@ -48,6 +78,7 @@ void Setting::importFile(const char* src, GameData& data)
         if (nodesSection)
         {
             data.coyoteTimeCursorPos = std::max(nodesSection["CoyoteTimeCursorMovement"].as<float>(), 0.f);
+            data.immediateDrag       = nodesSection["ImmediateDrag"].as<bool>(true);
             continue;
         }
 
@@ -59,6 +90,8 @@ void Setting::importFile(const char* src, GameData& data)
             data.showFrameBufferBackground = nodesSection["ShowFrameBufferBackground"].as<bool>();
             data.useForwardWindow          = nodesSection["UseForwardWindow"].as<bool>();
             data.useMousePassThoughWindow  = nodesSection["UseMousePassThoughWindow"].as<bool>();
+            data.usePartialRedraw          = nodesSection["UsePartialRedraw"].as<bool>(true);
+            data.spriteRenderer            = nodesSection["SpriteRenderer"].as<std::string>("Auto");
             continue;
         }
 
@@ -81,6 +114,14 @@ void Setting::importFile(const char* src, GameData& data)
         if (nodesSection)
         {
             data.debugEdgeDetection = nodesSection["ShowEdgeDetection"].as<bool>();
+            data.showProfiler       = nodesSection["ShowProfiler"].as<bool>(false);
+            data.metricsFile        = nodesSection["MetricsFile"].as<std::string>("");
+            data.metricsPeriod      = std::max(nodesSection["MetricsPeriod"].as<float>(15.f), 1.f);
+            data.controlSocketPath  = nodesSection["ControlSocket"].as<std::string>("");
+            data.GPUProfiling       = nodesSection["GPUProfiling"].as<bool>(false);
+            data.GPUProfileFile     = nodesSection["GPUProfileFile"].as<std::string>("");
+            Logger::instance().setMinLevel(
+                Logger::parseLevel(nodesSection["LogLevel"].as<std::string>(""), Logger::s_defaultMinLevel));
             continue;
         }
     }
@@ -96,6 +137,13 @@ void Setting::exportFile(const char* dest, GameData& data)
     }
 
     YAML::Emitter out;
+    emit(out, data);
+    fwrite(out.c_str(), sizeof(char), out.size(), file);
+    fclose(file);
+}
+
+void Setting::emit(YAML::Emitter& out, GameData& data)
+{
     out << YAML::BeginSeq;
     std::string section;
     {
@@ -105,6 +153,7 @@ void Setting::exportFile(const char* dest, GameData& data)
         out << YAML::BeginMap;
         out << YAML::Key << "FPS" << YAML::Value << data.FPS;
         out << YAML::Key << "RandomSeed" << YAML::Value << data.randomSeed;
+        out << YAML::Key << "ParallelAssetLoading" << YAML::Value << data.parallelAssetLoading;
         out << YAML::EndMap;
         out << YAML::EndMap;
     }
@@ -127,6 +176,7 @@ void Setting::exportFile(const char* dest, GameData& data)
             << data.collisionPixelRatioStopMovement;
         out << YAML::Key << "IsGroundedDetection" << YAML::Value << data.isGroundedDetection;
         out << YAML::Key << "InputReleaseImpulse" << YAML::Value << data.releaseImpulse;
+        out << YAML::Key << "ComputeCollision" << YAML::Value << data.computeCollision;
         out << YAML::EndMap;
         out << YAML::EndMap;
     }
@@ -137,6 +187,7 @@ void Setting::exportFile(const char* dest, GameData& data)
         out << section;
         out << YAML::BeginMap;
         out << YAML::Key << "CoyoteTimeCursorMovement" << YAML::Value << YAML::Precision(4) << data.coyoteTimeCursorPos;
+        out << YAML::Key << "ImmediateDrag" << YAML::Value << data.immediateDrag;
         out << YAML::EndMap;
         out << YAML::EndMap;
     }
@@ -151,6 +202,8 @@ void Setting::exportFile(const char* dest, GameData& data)
         out << YAML::Key << "ShowFrameBufferBackground" << YAML::Value << data.showFrameBufferBackground;
         out << YAML::Key << "UseForwardWindow" << YAML::Value << data.useForwardWindow;
         out << YAML::Key << "UseMousePassThoughWindow" << YAML::Value << data.useMousePassThoughWindow;
+        out << YAML::Key << "UsePartialRedraw" << YAML::Value << data.usePartialRedraw;
+        out << YAML::Key << "SpriteRenderer" << YAML::Value << data.spriteRenderer;
         out << YAML::EndMap;
         out << YAML::EndMap;
     }
@@ -182,10 +235,16 @@ void Setting::exportFile(const char* dest, GameData& data)
         out << section;
         out << YAML::BeginMap;
         out << YAML::Key << "ShowEdgeDetection" << YAML::Value << data.debugEdgeDetection;
+        out << YAML::Key << "ShowProfiler" << YAML::Value << data.showProfiler;
+        out << YAML::Key << "MetricsFile" << YAML::Value << data.metricsFile;
+        out << YAML::Key << "MetricsPeriod" << YAML::Value << data.metricsPeriod;
+        out << YAML::Key << "ControlSocket" << YAML::Value << data.controlSocketPath;
+        out << YAML::Key << "GPUProfiling" << YAML::Value << data.GPUProfiling;
+        out << YAML::Key << "GPUProfileFile" << YAML::Value << data.GPUProfileFile;
+        out << YAML::Key << "LogLevel" << YAML::Value
+            << Logger::s_levelNames[static_cast<size_t>(Logger::instance().getMinLevel())];
         out << YAML::EndMap;
         out << YAML::EndMap;
     }
     out << YAML::EndSeq;
-    fwrite(out.c_str(), sizeof(char), out.size(), file);
-    fclose(file);
 }
\ No newline at end of file
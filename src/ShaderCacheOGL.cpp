@@ -0,0 +1,188 @@
+#include "Engine/Graphics/ShaderCacheOGL.hpp"
+
+#include "Engine/Log.hpp"
+
+#include <glad/glad.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <vector>
+
+namespace
+{
+constexpr uint32_t s_cacheFileMagic = 0x50464443; // "PFDC"
+
+// Far above the binaries of the game shaders, a larger length comes from a corrupted file
+constexpr uint32_t s_maxBinaryLength = 16 * 1024 * 1024;
+
+// FNV-1a
+uint64_t hashString(const char* str, uint64_t hash = 14695981039346656037ull)
+{
+    for (; *str != '\0'; ++str)
+    {
+        hash ^= static_cast<unsigned char>(*str);
+        hash *= 1099511628211ull;
+    }
+    // Separator to avoid collision between concatenated strings
+    hash ^= 0xFF;
+    hash *= 1099511628211ull;
+    return hash;
+}
+
+struct CacheFileHeader
+{
+    uint32_t magic;
+    uint32_t format;
+    uint32_t length;
+};
+} // namespace
+
+std::filesystem::path ShaderCache::getUserCacheDirectory()
+{
+#if defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__NT__)
+    if (const char* localAppData = std::getenv("LOCALAPPDATA"))
+        return std::filesystem::path(localAppData) / PROJECT_NAME;
+#else
+    if (const char* xdgCache = std::getenv("XDG_CACHE_HOME"))
+        return std::filesystem::path(xdgCache) / PROJECT_NAME;
+    if (const char* home = std::getenv("HOME"))
+        return std::filesystem::path(home) / ".cache" / PROJECT_NAME;
+#endif
+    return std::filesystem::temp_directory_path() / PROJECT_NAME;
+}
+
+void ShaderCache::init()
+{
+    m_isInit = true;
+
+    GLint formatCount = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+    if (formatCount == 0)
+    {
+        log("Program binary not supported, shader cache disabled\n");
+        return;
+    }
+
+    // Binary is only valid for the driver that produced it
+    m_driverIdentifier = std::string(reinterpret_cast<const char*>(glGetString(GL_VENDOR))) + '|' +
+                         reinterpret_cast<const char*>(glGetString(GL_RENDERER)) + '|' +
+                         reinterpret_cast<const char*>(glGetString(GL_VERSION));
+
+    m_directory = getUserCacheDirectory() / "ShaderCache";
+    std::error_code error;
+    std::filesystem::create_directories(m_directory, error);
+    if (error)
+    {
+        logf("Cannot create shader cache directory \"%s\": %s\n", m_directory.string().c_str(),
+             error.message().c_str());
+        return;
+    }
+
+    m_isSupported = true;
+}
+
+std::filesystem::path ShaderCache::getCachePath(const char* vertexCode, const char* fragmentCode) const
+{
+    uint64_t hash = hashString(m_driverIdentifier.c_str());
+    hash          = hashString(vertexCode, hash);
+    hash          = hashString(fragmentCode, hash);
+
+    char fileName[32];
+    snprintf(fileName, sizeof(fileName), "%016llx.bin", static_cast<unsigned long long>(hash));
+    return m_directory / fileName;
+}
+
+bool ShaderCache::loadProgram(unsigned int program, const char* vertexCode, const char* fragmentCode)
+{
+    const bool isLoaded = tryLoadProgram(program, vertexCode, fragmentCode);
+    ++(isLoaded ? m_hitCount : m_missCount);
+    return isLoaded;
+}
+
+bool ShaderCache::tryLoadProgram(unsigned int program, const char* vertexCode, const char* fragmentCode)
+{
+    if (!m_isInit)
+        init();
+
+    if (!m_isSupported || vertexCode == nullptr || fragmentCode == nullptr)
+        return false;
+
+    const std::filesystem::path path = getCachePath(vertexCode, fragmentCode);
+    std::error_code             error;
+    const uintmax_t             fileSize = std::filesystem::file_size(path, error);
+    if (error || fileSize < sizeof(CacheFileHeader))
+        return false;
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+        return false;
+
+    // Corrupted or truncated file is a cache miss, it is replaced after the compilation
+    CacheFileHeader header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) || header.magic != s_cacheFileMagic ||
+        header.length == 0 || header.length > s_maxBinaryLength || header.length != fileSize - sizeof(header))
+        return false;
+
+    std::vector<char> binary(header.length);
+    if (!file.read(binary.data(), binary.size()))
+        return false;
+
+    glProgramBinary(program, header.format, binary.data(), static_cast<GLsizei>(binary.size()));
+
+    GLint success = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success)
+    {
+        log("Program binary rejected by the driver, fallback on shaders compilation\n");
+        return false;
+    }
+    return true;
+}
+
+void ShaderCache::saveProgram(unsigned int program, const char* vertexCode, const char* fragmentCode)
+{
+    if (!m_isInit)
+        init();
+
+    if (!m_isSupported || vertexCode == nullptr || fragmentCode == nullptr)
+        return;
+
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0)
+        return;
+
+    std::vector<char> binary(length);
+    GLenum            format = 0;
+    glGetProgramBinary(program, length, nullptr, &format, binary.data());
+
+    // Written next to the entry then renamed: a crash while writing can't leave a partial entry
+    const std::filesystem::path path     = getCachePath(vertexCode, fragmentCode);
+    std::filesystem::path       tempPath = path;
+    tempPath += ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file)
+            return;
+
+        const CacheFileHeader header{s_cacheFileMagic, format, static_cast<uint32_t>(length)};
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(binary.data(), binary.size());
+        file.close();
+        if (!file)
+        {
+            std::error_code error;
+            std::filesystem::remove(tempPath, error);
+            return;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(tempPath, path, error);
+    if (error)
+    {
+        logf(ELogLevel::Warning, "Cannot write the shader cache entry \"%s\": %s\n", path.string().c_str(),
+             error.message().c_str());
+        std::filesystem::remove(tempPath, error);
+    }
+}
@@ -0,0 +1,109 @@
+#include "Engine/Graphics/SpriteRendererCPU.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+SpriteRendererCPU::SpriteRendererCPU(Window& window, Shader& imageShader, ScreenSpaceQuad& fullScreenQuad)
+    : m_window{window}, m_imageShader{imageShader}, m_fullScreenQuad{fullScreenQuad}, m_target{1, 1, 4}
+{
+}
+
+void SpriteRendererCPU::beginFrame(const Canvas::DamageRegion& damage)
+{
+    const int width  = static_cast<int>(m_window.getSize().x);
+    const int height = static_cast<int>(m_window.getSize().y);
+    if (width != m_width || height != m_height)
+    {
+        // Window resize redraw everything, previous content can be lost
+        m_width  = width;
+        m_height = height;
+        m_pixels.resize(static_cast<size_t>(m_width) * m_height * 4);
+        m_target.resize(m_width, m_height);
+    }
+
+    m_damage = damage;
+    if (m_damage.isEmpty())
+        return;
+
+    // Same clear than the back buffer: transparent black
+    const size_t rowBytes = static_cast<size_t>(m_damage.max.x - m_damage.min.x) * 4;
+    for (int y = m_damage.min.y; y < m_damage.max.y; ++y)
+        memset(&m_pixels[(static_cast<size_t>(m_height - 1 - y) * m_width + m_damage.min.x) * 4], 0, rowBytes);
+}
+
+void SpriteRendererCPU::drawSprite(const Texture& texture, const Rect& rect, float uOffset, float uScale)
+{
+    const unsigned char* texels = texture.getData();
+    if (texels == nullptr || m_damage.isEmpty())
+        return;
+
+    // Pixels whose center is inside the rect, like the rasterizer
+    const Vec2 cornerMin = rect.getCornerMin() - m_window.getPosition();
+    const Vec2 size      = rect.getSize();
+    const int  minX      = std::max(static_cast<int>(std::ceil(cornerMin.x - 0.5f)), m_damage.min.x);
+    const int  minY      = std::max(static_cast<int>(std::ceil(cornerMin.y - 0.5f)), m_damage.min.y);
+    const int  maxX      = std::min(static_cast<int>(std::ceil(cornerMin.x + size.x - 0.5f)), m_damage.max.x);
+    const int  maxY      = std::min(static_cast<int>(std::ceil(cornerMin.y + size.y - 0.5f)), m_damage.max.y);
+    if (minX >= maxX || minY >= maxY)
+        return;
+
+    const int texWidth  = texture.getWidth();
+    const int texHeight = texture.getHeight();
+    const int channels  = texture.getChannelsCount();
+
+    // Horizontal sampling is the same for all the rows
+    m_texelColumns.resize(maxX - minX);
+    for (int x = minX; x < maxX; ++x)
+    {
+        const float u            = uOffset + (x + 0.5f - cornerMin.x) / size.x * uScale;
+        m_texelColumns[x - minX] = std::clamp(static_cast<int>(std::floor(u * texWidth)), 0, texWidth - 1) * channels;
+    }
+
+    for (int y = minY; y < maxY; ++y)
+    {
+        // Texture rows are bottom up, texture coordinate 0 is the bottom of the sprite
+        const float v        = 1.f - (y + 0.5f - cornerMin.y) / size.y;
+        const int   texelRow = std::clamp(static_cast<int>(std::floor(v * texHeight)), 0, texHeight - 1);
+
+        const unsigned char* srcRow = texels + static_cast<size_t>(texelRow) * texWidth * channels;
+        unsigned char*       dstRow = &m_pixels[static_cast<size_t>(m_height - 1 - y) * m_width * 4];
+        for (int x = minX; x < maxX; ++x)
+        {
+            const unsigned char* src   = srcRow + m_texelColumns[x - minX];
+            unsigned char*       dst   = dstRow + x * 4;
+            const int            alpha = channels == 4 ? src[3] : 255;
+            if (alpha == 0)
+                continue;
+
+            // Source RGB(A), destination BGRA. Blend function of the back buffer: SRC_ALPHA, ONE_MINUS_SRC_ALPHA
+            const int inverseAlpha = 255 - alpha;
+            dst[0] = static_cast<unsigned char>((src[2] * alpha + dst[0] * inverseAlpha + 127) / 255);
+            dst[1] = static_cast<unsigned char>((src[1] * alpha + dst[1] * inverseAlpha + 127) / 255);
+            dst[2] = static_cast<unsigned char>((src[0] * alpha + dst[2] * inverseAlpha + 127) / 255);
+            dst[3] = static_cast<unsigned char>((alpha * alpha + dst[3] * inverseAlpha + 127) / 255);
+        }
+    }
+}
+
+void SpriteRendererCPU::endFrame()
+{
+    if (m_damage.isEmpty())
+        return;
+
+    // Only the damaged rows and columns are uploaded
+    const int    regionWidth  = m_damage.max.x - m_damage.min.x;
+    const int    regionHeight = m_damage.max.y - m_damage.min.y;
+    const int    bottomRow    = m_height - m_damage.max.y;
+    const size_t firstPixel   = static_cast<size_t>(bottomRow) * m_width + m_damage.min.x;
+    m_target.updateRegion(&m_pixels[firstPixel * 4], m_damage.min.x, bottomRow, regionWidth, regionHeight, m_width);
+
+    // Already blended: copied over the cleared back buffer, restricted to the damage by the scissor test
+    GLState& state = GLState::instance();
+    state.setCapability(GLState::ECapability::Blend, false);
+    m_imageShader.use();
+    m_target.use();
+    m_fullScreenQuad.use();
+    m_fullScreenQuad.draw();
+    state.setCapability(GLState::ECapability::Blend, true);
+}
@@ -0,0 +1,52 @@
+#include "Engine/SystemInfo.hpp"
+
+#if defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__NT__)
+#include <Windows.h>
+#include <psapi.h>
+#else
+#include <cstdio>
+#include <ctime>
+#include <unistd.h>
+#endif
+
+double getProcessCPUTime()
+{
+#if defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__NT__)
+    FILETIME creationTime, exitTime, kernelTime, userTime;
+    if (!GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime))
+        return 0.;
+
+    // FILETIME is expressed in 100 nanoseconds unit
+    const ULONGLONG kernel = (static_cast<ULONGLONG>(kernelTime.dwHighDateTime) << 32) | kernelTime.dwLowDateTime;
+    const ULONGLONG user   = (static_cast<ULONGLONG>(userTime.dwHighDateTime) << 32) | userTime.dwLowDateTime;
+    return (kernel + user) * 1e-7;
+#else
+    timespec time;
+    if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time) != 0)
+        return 0.;
+
+    return time.tv_sec + time.tv_nsec * 1e-9;
+#endif
+}
+
+size_t getProcessResidentMemory()
+{
+#if defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__NT__)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return 0;
+
+    return counters.WorkingSetSize;
+#else
+    // Second field is the resident size in pages
+    FILE* file = fopen("/proc/self/statm", "r");
+    if (file == nullptr)
+        return 0;
+
+    unsigned long size     = 0;
+    unsigned long resident = 0;
+    const int     count    = fscanf(file, "%lu %lu", &size, &resident);
+    fclose(file);
+    return count == 2 ? resident * static_cast<size_t>(sysconf(_SC_PAGESIZE)) : 0;
+#endif
+}
@@ -1,4 +1,6 @@
 #include "Engine/Graphics/TextureOGL.hpp"
+#include "Engine/Graphics/GPUProfilerOGL.hpp"
+#include "Engine/ImageLoader.hpp"
 
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
@@ -6,19 +8,28 @@
 Texture::Texture(const char* srcPath, bool verticalFlip, std::function<void()> setupCallback)
 {
     glGenTextures(1, &ID);
-    glBindTexture(GL_TEXTURE_2D, ID);
+    GLState::instance().bindTexture(ID);
 
     setupCallback();
 
-    // load image, create texture and generate mipmaps
-    stbi_set_flip_vertically_on_load(verticalFlip); // tell stb_image.h to flip loaded texture's on the y-axis.
-    data = stbi_load(srcPath, &width, &height, &nbChannels, 0);
+    // load image (may be already decoded by the loader workers), create texture and generate mipmaps
+    ImageLoader::Image image = ImageLoader::instance().takeImage(srcPath, verticalFlip);
+    data                     = image.data;
+    opacityMask              = image.opacityMask;
+    ownsData                 = image.isOwned;
+    width                    = image.width;
+    height                   = image.height;
+    nbChannels               = image.channels;
     if (data)
     {
         if (nbChannels == 4)
             glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
         else
             glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
+
+        GPUByteCount = static_cast<size_t>(width) * height * (nbChannels == 4 ? 4 : 3);
+        s_GPUByteCount += GPUByteCount;
+        GPUProfiler::instance().addUpload(GPUByteCount);
     }
     else
     {
@@ -29,7 +40,7 @@ Texture::Texture(const char* srcPath, bool verticalFlip, std::function<void()> s
 Texture::Texture(void* data, int pxlWidth, int pxlHeight, int channels, std::function<void()> setupCallback)
 {
     glGenTextures(1, &ID);
-    glBindTexture(GL_TEXTURE_2D, ID);
+    GLState::instance().bindTexture(ID);
 
     setupCallback();
 
@@ -38,12 +49,16 @@ Texture::Texture(void* data, int pxlWidth, int pxlHeight, int channels, std::fun
     nbChannels      = channels;
     GLenum chanEnum = getChanelEnum();
     glTexImage2D(GL_TEXTURE_2D, 0, chanEnum, width, height, 0, GL_BGRA, GL_UNSIGNED_BYTE, data);
+
+    GPUByteCount = static_cast<size_t>(width) * height * nbChannels;
+    s_GPUByteCount += GPUByteCount;
+    GPUProfiler::instance().addUpload(static_cast<uint64_t>(width) * height * 4); // Source is BGRA
 }
 
 Texture::Texture(int pxlWidth, int pxlHeight, int channels, std::function<void()> setupCallback)
 {
     glGenTextures(1, &ID);
-    glBindTexture(GL_TEXTURE_2D, ID);
+    GLState::instance().bindTexture(ID);
 
     setupCallback();
 
@@ -53,11 +68,65 @@ Texture::Texture(int pxlWidth, int pxlHeight, int channels, std::function<void()
     GLenum chanEnum = getChanelEnum();
 
     glTexImage2D(GL_TEXTURE_2D, 0, chanEnum, width, height, 0, chanEnum, GL_UNSIGNED_BYTE, 0);
+
+    GPUByteCount = static_cast<size_t>(width) * height * nbChannels;
+    s_GPUByteCount += GPUByteCount;
+}
+
+void Texture::update(const void* pixels, int pxlWidth, int pxlHeight, int rowLength)
+{
+    GLState::instance().bindTexture(ID);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, rowLength);
+
+    if (pxlWidth == width && pxlHeight == height)
+    {
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_BGRA, GL_UNSIGNED_BYTE, pixels);
+    }
+    else
+    {
+        width  = pxlWidth;
+        height = pxlHeight;
+        glTexImage2D(GL_TEXTURE_2D, 0, getChanelEnum(), width, height, 0, GL_BGRA, GL_UNSIGNED_BYTE, pixels);
+
+        s_GPUByteCount -= GPUByteCount;
+        GPUByteCount = static_cast<size_t>(width) * height * nbChannels;
+        s_GPUByteCount += GPUByteCount;
+    }
+
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    GPUProfiler::instance().addUpload(static_cast<uint64_t>(width) * height * 4); // Source is BGRA
+}
+
+void Texture::updateRegion(const void* pixels, int x, int y, int pxlWidth, int pxlHeight, int rowLength)
+{
+    GLState::instance().bindTexture(ID);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, rowLength);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, pxlWidth, pxlHeight, GL_BGRA, GL_UNSIGNED_BYTE, pixels);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    GPUProfiler::instance().addUpload(static_cast<uint64_t>(pxlWidth) * pxlHeight * 4);
+}
+
+void Texture::resize(int pxlWidth, int pxlHeight)
+{
+    if (pxlWidth == width && pxlHeight == height)
+        return;
+
+    width           = pxlWidth;
+    height          = pxlHeight;
+    GLenum chanEnum = getChanelEnum();
+    GLState::instance().bindTexture(ID);
+    glTexImage2D(GL_TEXTURE_2D, 0, chanEnum, width, height, 0, chanEnum, GL_UNSIGNED_BYTE, 0);
+
+    s_GPUByteCount -= GPUByteCount;
+    GPUByteCount = static_cast<size_t>(width) * height * nbChannels;
+    s_GPUByteCount += GPUByteCount;
 }
 
 Texture::~Texture()
 {
-    if (data != nullptr)
+    if (data != nullptr && ownsData)
         stbi_image_free(data);
     glDeleteTextures(1, &ID);
+    GLState::instance().onTextureDeleted(ID);
+    s_GPUByteCount -= GPUByteCount;
 }
\ No newline at end of file
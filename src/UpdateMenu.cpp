@@ -7,6 +7,7 @@
 
 #include <cpr/cpr.h>
 #include <regex>
+#include <sstream>
 #include <string>
 
 void UpdateMenu::changeFileExtension(char* file_name)
@@ -94,6 +95,14 @@ UpdateMenu::UpdateMenu(GameData& inDatas, Vec2 inPosition, const char* inContent
     {
         changelog = markdownToPlainText(matches[1].str());
     }
+
+    // Split once, the lines are drawn each frame
+    std::istringstream iss(changelog);
+    std::string        line;
+    while (std::getline(iss, line))
+    {
+        lines.push_back(line);
+    }
 }
 
 void UpdateMenu::update(double deltaTime)
@@ -107,26 +116,18 @@ void UpdateMenu::update(double deltaTime)
 
     ImVec2 sizeButton = ImVec2(ImGui::GetContentRegionAvail().x, 0.0f);
 
-    std::istringstream       iss(changelog);
-    std::vector<std::string> lines;
-    std::string              line;
-    while (std::getline(iss, line))
-    {
-        lines.push_back(line);
-    }
-
     // Process each line and log the desired parts using ImGui::Text
     for (const std::string& line : lines)
     {
         size_t urlStartPos = line.find("https://github.com/");
         if (urlStartPos != std::string::npos)
         {
-            std::string authorText = line.substr(0, urlStartPos);
-            std::string urlText    = line.substr(urlStartPos);
+            // The URL is the end of the line, no copy is needed
+            const char* urlText = line.c_str() + urlStartPos;
 
             // Log the author text and URL using ImGui::Text
-            ImGui::Text("%s", authorText.c_str());
-            ImGui::textURL(urlText.c_str(), urlText.c_str(), 1, 0);
+            ImGui::TextUnformatted(line.c_str(), urlText);
+            ImGui::textURL(urlText, urlText, 1, 0);
         }
         else
         {
@@ -3,10 +3,22 @@
 #include "Game/GameData.hpp"
 #include "Engine/Log.hpp"
 #include "Engine/Graphics/WindowOGL.hpp"
+#include "Engine/InteractionSystem.hpp"
+#include "Engine/TimeManager.hpp"
 #include "Game/Pet.hpp"
 
-void WindowGLFW::initGLFW()
+void WindowGLFW::initGLFW(bool headless)
 {
+    if (headless)
+    {
+#ifdef GLFW_PLATFORM_NULL
+        // No display needed, the context is created with EGL or OSMesa
+        glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+#else
+        errorAndExit("Headless mode requires GLFW 3.4 or newer");
+#endif
+    }
+
     // initialize the library
     if (!glfwInit())
         errorAndExit("glfw initialization error");
@@ -26,6 +38,7 @@ void WindowGLFW::preSetupWindow(const GameData& datas)
 void WindowGLFW::postSetupWindow(GameData& datas)
 {
     useMousePassThrough = datas.useMousePassThoughWindow;
+    useFitToElements    = !datas.fullScreenWindow;
     isMousePassThrough = true;
     glfwSetWindowAttrib(datas.window->getWindow(), GLFW_MOUSE_PASSTHROUGH, isMousePassThrough);
     glfwSetWindowAttrib(datas.window->getWindow(), GLFW_TRANSPARENT_FRAMEBUFFER, true);
@@ -44,6 +57,17 @@ void WindowGLFW::initWindow(GameData& datas)
 
     m_size = {1.f, 1.f};
     window = glfwCreateWindow(m_size.x, m_size.y, PROJECT_NAME, NULL, NULL);
+
+#ifdef GLFW_PLATFORM_NULL
+    // Surfaceless EGL is not available everywhere, OSMesa render with llvmpipe without any driver
+    if (!window && datas.headless)
+    {
+        log("EGL context creation failed, fallback to OSMesa\n");
+        glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_OSMESA_CONTEXT_API);
+        window = glfwCreateWindow(m_size.x, m_size.y, PROJECT_NAME, NULL, NULL);
+    }
+#endif
+
     if (!window)
     {
         glfwTerminate();
@@ -69,15 +93,31 @@ void cursorPositionCallback(GLFWwindow* window, double x, double y)
         datas.deltaCursorPosY += globalScreenPosY - datas.prevCursorPosY;
         datas.prevCursorPosX = globalScreenPosX;
         datas.prevCursorPosY = globalScreenPosY;
-        Vec2 delta(datas.deltaCursorPosX, datas.deltaCursorPosY);
-        datas.deltasCursorPosBuffer.emplace(datas.timeAcc, delta);
-        datas.deltaCursorAcc += delta;
+        datas.cursorTracker.addSample(glfwGetTime(), {globalScreenPosX, globalScreenPosY});
+
+        if (datas.interactionSystem->isDragging())
+        {
+            TimeManager::instance().markInput();
+
+            // Move the grabbed pet now and render it during this update instead of waiting the next physic step
+            if (datas.immediateDrag)
+            {
+                datas.interactionSystem->applyDrag({datas.deltaCursorPosX, datas.deltaCursorPosY});
+                datas.deltaCursorPosX = 0.f;
+                datas.deltaCursorPosY = 0.f;
+                TimeManager::instance().markInputApplied();
+                TimeManager::instance().requestLimitedUpdate();
+            }
+        }
     }
 }
 
 void mousButtonCallBack(GLFWwindow* window, int button, int action, int mods)
 {
     GameData& datas = *static_cast<GameData*>(glfwGetWindowUserPointer(window));
+
+    // Transitions relying on click need to be evaluated during the same frame
+    TimeManager::instance().requestLimitedUpdate();
    
     switch (button)
     {
@@ -91,6 +131,8 @@ void mousButtonCallBack(GLFWwindow* window, int button, int action, int mods)
             datas.prevCursorPosY  = static_cast<float>(datas.window->getPosition().y + datas.cursorPos.y);
             datas.deltaCursorPosX = 0.f;
             datas.deltaCursorPosY = 0.f;
+            datas.cursorTracker.clear();
+            datas.cursorTracker.addSample(glfwGetTime(), {datas.prevCursorPosX, datas.prevCursorPosY});
             break;
         }
         case GLFW_RELEASE:
@@ -112,9 +154,12 @@ void processInput(GLFWwindow* window)
     GameData& datas = *static_cast<GameData*>(glfwGetWindowUserPointer(window));
 
     // Need always capture the mouse position to trigger the pass through
-    double cursPosX, cursPosY;
-    glfwGetCursorPos(window, &cursPosX, &cursPosY);
-    datas.cursorPos = {static_cast<int>(floor(cursPosX)), static_cast<int>(floor(cursPosY))};
+    if (!datas.isCursorControlled)
+    {
+        double cursPosX, cursPosY;
+        glfwGetCursorPos(window, &cursPosX, &cursPosY);
+        datas.cursorPos = {static_cast<int>(floor(cursPosX)), static_cast<int>(floor(cursPosY))};
+    }
     
     if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
         glfwSetWindowShouldClose(window, true);
@@ -1,9 +1,24 @@
 #include "Engine/Graphics/WindowOGL.hpp"
 #include "Engine/Graphics/FramebufferOGL.hpp"
+#include "Engine/Graphics/GLStateOGL.hpp"
 
 #include "Engine/Log.hpp"
 #include "Game/GameData.hpp"
 
+#include <cstring>
+
+bool Window::isSoftwareRenderer(const char* renderer)
+{
+    static constexpr const char* s_softwareRenderers[] = {"llvmpipe", "softpipe", "SwiftShader",
+                                                          "Microsoft Basic Render Driver", "GDI Generic"};
+    for (const char* softwareRenderer : s_softwareRenderers)
+    {
+        if (strstr(renderer, softwareRenderer) != nullptr)
+            return true;
+    }
+    return false;
+}
+
 void Window::initGraphicAPI()
 {
     // glad: load all OpenGL function pointers
@@ -18,10 +33,20 @@ void Window::initGraphicAPI()
 
 void Window::init(GameData& datas)
 {
-    initGLFW();
+    initGLFW(datas.headless);
 
+    // 4.5 is the highest version exposed by Mesa llvmpipe
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 5);
+
+#ifdef GLFW_PLATFORM_NULL
+    if (datas.headless)
+    {
+        // Mesa only expose recent versions with the core profile
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+        glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_EGL_CONTEXT_API);
+    }
+#endif
 
 #ifdef _DEBUG
     glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GL_TRUE);
@@ -33,20 +58,49 @@ void Window::init(GameData& datas)
 
     initWindow(datas);
     initGraphicAPI();
+
+    m_usePartialRedraw = datas.usePartialRedraw;
+
+    // Each covered pixel cost CPU time: only draw the area around the elements and only the damaged part of it
+    const char* renderer = reinterpret_cast<const char*>(glGetString(GL_RENDERER));
+    m_isSoftwareRenderer = renderer != nullptr && isSoftwareRenderer(renderer);
+    if (m_isSoftwareRenderer)
+    {
+        logf("Software renderer detected (%s): full screen window and full redraw are disabled\n", renderer);
+        m_usePartialRedraw = true;
+        useFitToElements   = true;
+    }
 }
 
-void Window::initDrawContext()
+Window::DamageRegion Window::initDrawContext(bool fullRedraw)
 {
     Framebuffer::bindScreen();
 
-    glViewport(0, 0, m_size.x, m_size.y);
+    GLState& state = GLState::instance();
+    state.viewport(0, 0, m_size.x, m_size.y);
+
+    // Elements damage need to be consumed each frame to keep history coherent
+    DamageRegion damage = computeFrameDamage();
+    if (m_usePartialRedraw && !fullRedraw)
+    {
+        // Scissor use bottom left origin
+        state.setCapability(GLState::ECapability::ScissorTest, true);
+        glScissor(damage.min.x, static_cast<int>(m_size.y) - damage.max.y, damage.max.x - damage.min.x,
+                  damage.max.y - damage.min.y);
+    }
+    else
+    {
+        state.setCapability(GLState::ECapability::ScissorTest, false);
+        damage = {{0, 0}, {static_cast<int>(m_size.x), static_cast<int>(m_size.y)}};
+    }
 
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
-    glActiveTexture(GL_TEXTURE0);
-    glDisable(GL_DEPTH_TEST);
-    glDepthMask(GL_TRUE);
+    state.setCapability(GLState::ECapability::Blend, true);
+    state.blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    state.clearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    state.activeTexture(0);
+    state.setCapability(GLState::ECapability::DepthTest, false);
+    state.depthMask(true);
     glClear(GL_COLOR_BUFFER_BIT);
-    glDisable(GL_CULL_FACE);
+    state.setCapability(GLState::ECapability::CullFace, false);
+    return damage;
 }
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include "Game/Game.hpp"
 
+#include <cstring>
+
 // Disable usage of external GPU
 #ifdef __cplusplus
 extern "C"
@@ -19,7 +21,14 @@ extern "C"
 
 int main(int argc, char** argv)
 {
-    Game game;
+    bool headless = false;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "--headless") == 0)
+            headless = true;
+    }
+
+    Game game(headless);
     game.run();
 
     return 0;
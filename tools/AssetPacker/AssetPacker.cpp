@@ -0,0 +1,165 @@
+// Build time tool: decode every sprite of the content directory into a pack that the game memory maps at startup.
+// Usage: AssetPacker <content directory> <output pack path>
+
+#include "Engine/AssetPack.hpp"
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+struct PackedImage
+{
+    AssetPackFormat::Entry     entry{};
+    std::vector<unsigned char> pixels;
+    std::vector<unsigned char> opacityMask;
+};
+
+static uint64_t alignOffset(uint64_t offset)
+{
+    return (offset + AssetPackFormat::dataAlignment - 1) / AssetPackFormat::dataAlignment *
+           AssetPackFormat::dataAlignment;
+}
+
+static bool packImage(const fs::path& contentDir, const fs::path& imagePath, PackedImage& packedImage)
+{
+    const std::string relativePath = fs::relative(imagePath, contentDir).generic_string();
+    if (relativePath.size() >= sizeof(packedImage.entry.path))
+    {
+        fprintf(stderr, "Path \"%s\" is too long and is skipped\n", relativePath.c_str());
+        return false;
+    }
+
+    std::ifstream                    file(imagePath, std::ios::binary);
+    const std::vector<unsigned char> source{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+
+    // Same orientation than the one requested by the game: logos are used by ImGui, other sprites by OpenGL
+    const bool verticalFlip = relativePath.find("/logo/") == std::string::npos;
+
+    int width, height, channels;
+    stbi_set_flip_vertically_on_load(verticalFlip);
+    unsigned char* pixels = stbi_load_from_memory(source.data(), static_cast<int>(source.size()), &width, &height,
+                                                  &channels, 0);
+    if (pixels == nullptr)
+    {
+        fprintf(stderr, "Failed to decode \"%s\": %s\n", relativePath.c_str(), stbi_failure_reason());
+        return false;
+    }
+
+    AssetPackFormat::Entry& entry = packedImage.entry;
+    strncpy(entry.path, relativePath.c_str(), sizeof(entry.path) - 1);
+    entry.width      = static_cast<uint32_t>(width);
+    entry.height     = static_cast<uint32_t>(height);
+    entry.channels   = static_cast<uint32_t>(channels);
+    entry.flags      = verticalFlip ? AssetPackFormat::VerticalFlip : 0;
+    entry.sourceSize = source.size();
+
+    const size_t pixelsCount = static_cast<size_t>(width) * height;
+    packedImage.pixels.assign(pixels, pixels + pixelsCount * channels);
+
+    // Mask only useful for the collision test of the sprites with alpha
+    if (channels == 4)
+    {
+        packedImage.opacityMask.assign((pixelsCount + 7) / 8, 0);
+        for (size_t i = 0; i < pixelsCount; ++i)
+        {
+            if (pixels[i * 4 + 3] > 0)
+                packedImage.opacityMask[i / 8] |= 1 << (i % 8);
+        }
+    }
+
+    stbi_image_free(pixels);
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc != 3)
+    {
+        fprintf(stderr, "Usage: %s <content directory> <output pack path>\n", argv[0]);
+        return 1;
+    }
+
+    const fs::path contentDir = argv[1];
+    const fs::path outputPath = argv[2];
+
+    std::vector<fs::path> imagePaths;
+    for (const fs::directory_entry& file : fs::recursive_directory_iterator(contentDir / "sprites"))
+    {
+        if (file.is_regular_file() && file.path().extension() == ".png")
+            imagePaths.emplace_back(file.path());
+    }
+
+    std::vector<PackedImage> images;
+    for (const fs::path& imagePath : imagePaths)
+    {
+        PackedImage packedImage;
+        if (packImage(contentDir, imagePath, packedImage))
+            images.emplace_back(std::move(packedImage));
+    }
+    // Deterministic pack for the same content, in the order of the binary search of the game
+    std::sort(images.begin(), images.end(), [](const PackedImage& lhs, const PackedImage& rhs) {
+        return strncmp(lhs.entry.path, rhs.entry.path, sizeof(lhs.entry.path)) < 0;
+    });
+
+    uint64_t offset = sizeof(AssetPackFormat::Header) + images.size() * sizeof(AssetPackFormat::Entry);
+    for (PackedImage& image : images)
+    {
+        offset                   = alignOffset(offset);
+        image.entry.pixelsOffset = offset;
+        image.entry.pixelsSize   = image.pixels.size();
+        offset += image.pixels.size();
+
+        offset                        = alignOffset(offset);
+        image.entry.opacityMaskOffset = image.opacityMask.empty() ? 0 : offset;
+        image.entry.opacityMaskSize   = image.opacityMask.size();
+        offset += image.opacityMask.size();
+    }
+
+    // Pack target doesn't wait for the copy of the content directory
+    std::error_code error;
+    fs::create_directories(outputPath.parent_path(), error);
+
+    std::ofstream output(outputPath, std::ios::binary | std::ios::trunc);
+    if (!output)
+    {
+        fprintf(stderr, "Failed to open \"%s\"\n", outputPath.string().c_str());
+        return 1;
+    }
+
+    const AssetPackFormat::Header header{AssetPackFormat::magic, AssetPackFormat::version,
+                                         static_cast<uint32_t>(images.size()), 0};
+    output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (const PackedImage& image : images)
+    {
+        output.write(reinterpret_cast<const char*>(&image.entry), sizeof(image.entry));
+    }
+
+    const auto writeAt = [&](uint64_t dataOffset, const std::vector<unsigned char>& data) {
+        if (data.empty())
+            return;
+        // Fill the alignment padding
+        while (static_cast<uint64_t>(output.tellp()) < dataOffset)
+            output.put(0);
+        output.write(reinterpret_cast<const char*>(data.data()), data.size());
+    };
+
+    for (const PackedImage& image : images)
+    {
+        writeAt(image.entry.pixelsOffset, image.pixels);
+        writeAt(image.entry.opacityMaskOffset, image.opacityMask);
+    }
+
+    printf("%zu images packed in \"%s\" (%llu bytes)\n", images.size(), outputPath.string().c_str(),
+           static_cast<unsigned long long>(output.tellp()));
+    return 0;
+}
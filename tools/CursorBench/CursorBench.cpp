@@ -0,0 +1,146 @@
+// Replay a synthetic high rate mouse trace through the cursor tracker and the previous priority queue buffer.
+// Usage: cursor_bench [mouse rate in Hz] [duration in seconds]
+
+#include "Engine/CursorTracker.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <queue>
+#include <vector>
+
+namespace
+{
+constexpr double s_coyoteTime = 0.1;
+constexpr double s_frameRate  = 60.;
+
+struct TracePoint
+{
+    double time;
+    Vec2   position;
+    Vec2   velocity; // Exact, in pixel per second
+};
+
+// Throws in loop: the cursor oscillates on x with a varying amplitude and drifts on y. Positions are rounded to the
+// pixel like the real cursor.
+std::vector<TracePoint> generateTrace(double rate, double duration)
+{
+    std::vector<TracePoint> trace;
+    trace.reserve(static_cast<size_t>(rate * duration));
+
+    for (double t = 0.; t < duration; t += 1. / rate)
+    {
+        const double amplitude = 300. + 200. * std::sin(t * 0.7);
+        const double pulsation = 2. * 3.14159265 * 0.8;
+        TracePoint   point;
+        point.time     = t;
+        point.position = {static_cast<float>(std::round(960. + amplitude * std::sin(pulsation * t))),
+                          static_cast<float>(std::round(540. + 100. * std::sin(t * 0.3)))};
+        point.velocity = {static_cast<float>(amplitude * pulsation * std::cos(pulsation * t) +
+                                             200. * 0.7 * std::cos(t * 0.7) * std::sin(pulsation * t)),
+                          static_cast<float>(100. * 0.3 * std::cos(t * 0.3))};
+        trace.emplace_back(point);
+    }
+    return trace;
+}
+
+// Previous implementation: deltas pushed in a priority queue and removed when older than the coyote time
+struct LegacyBuffer
+{
+    struct Elem
+    {
+        float timer;
+        Vec2  pos;
+
+        bool operator>(const Elem& other) const noexcept
+        {
+            return timer > other.timer;
+        }
+    };
+
+    std::priority_queue<Elem, std::vector<Elem>, std::greater<Elem>> buffer;
+    Vec2                                                             acc{0.f, 0.f};
+    Vec2                                                             previous{0.f, 0.f};
+
+    void addSample(double time, Vec2 position)
+    {
+        const Vec2 delta = position - previous;
+        previous         = position;
+        buffer.push({static_cast<float>(time), delta});
+        acc += delta;
+    }
+
+    void removeSamplesBefore(double time)
+    {
+        while (!buffer.empty() && buffer.top().timer < time)
+        {
+            acc -= buffer.top().pos;
+            buffer.pop();
+        }
+    }
+
+    Vec2 computeVelocity() const
+    {
+        return acc / static_cast<float>(s_coyoteTime);
+    }
+};
+
+template <typename TAddSample, typename TRemove, typename TVelocity>
+void replay(const char* name, const std::vector<TracePoint>& trace, TAddSample addSample, TRemove removeSamplesBefore,
+            TVelocity computeVelocity)
+{
+    double sqrError      = 0.;
+    double sqrReference  = 0.;
+    size_t releaseCount  = 0;
+    double nextFrameTime = 1. / s_frameRate;
+
+    const auto begin = std::chrono::steady_clock::now();
+    for (const TracePoint& point : trace)
+    {
+        addSample(point.time, point.position);
+
+        // Main loop wake up: prune the samples and pretend a release to measure the estimation
+        if (point.time >= nextFrameTime)
+        {
+            nextFrameTime += 1. / s_frameRate;
+            removeSamplesBefore(point.time - s_coyoteTime);
+
+            const Vec2 velocity = computeVelocity(point.time, point.position);
+            const Vec2 error    = velocity - point.velocity;
+            sqrError += error.x * error.x + error.y * error.y;
+            sqrReference += point.velocity.x * point.velocity.x + point.velocity.y * point.velocity.y;
+            ++releaseCount;
+        }
+    }
+    const double duration_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count();
+
+    printf("%-14s %8.1f ns/sample, relative velocity error %5.1f%% (%zu releases)\n", name,
+           duration_ns / trace.size(), std::sqrt(sqrError / std::max(sqrReference, 1e-9)) * 100., releaseCount);
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const double rate     = argc > 1 ? std::max(atof(argv[1]), 1.) : 1000.;
+    const double duration = argc > 2 ? std::max(atof(argv[2]), 1.) : 60.;
+
+    const std::vector<TracePoint> trace = generateTrace(rate, duration);
+    printf("%zu samples at %.0f Hz, coyote time %.0f ms\n", trace.size(), rate, s_coyoteTime * 1000.);
+
+    LegacyBuffer legacy;
+    legacy.previous = trace.front().position;
+    replay(
+        "priority_queue", trace, [&](double time, Vec2 position) { legacy.addSample(time, position); },
+        [&](double time) { legacy.removeSamplesBefore(time); },
+        [&](double, Vec2) { return legacy.computeVelocity(); });
+
+    static CursorTracker tracker;
+    replay(
+        "CursorTracker", trace, [&](double time, Vec2 position) { tracker.addSample(time, position); },
+        [&](double time) { tracker.removeSamplesBefore(time); },
+        [&](double time, Vec2 position) { return tracker.computeVelocity(time, s_coyoteTime, position); });
+
+    return 0;
+}
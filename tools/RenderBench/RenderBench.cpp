@@ -0,0 +1,40 @@
+// Render the normal frame of the game without display, on Mesa llvmpipe if no GPU is available.
+// Usage: render_bench [pet count] [frame count] [--window] [--no-allocation]
+// With --no-allocation, exit with a failure if a frame after the warm up allocated on the heap. Frames include a
+// physic step of each pet, with its screen capture and collision pass.
+
+#include "Game/Game.hpp"
+
+#include <cstdlib>
+#include <cstring>
+
+int main(int argc, char** argv)
+{
+    size_t petCount     = 10;
+    size_t frameCount   = 600;
+    bool   headless     = true;
+    bool   noAllocation = false;
+
+    int positionalIndex = 0;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "--window") == 0)
+            headless = false;
+        else if (strcmp(argv[i], "--no-allocation") == 0)
+            noAllocation = true;
+        else if (positionalIndex++ == 0)
+            petCount = std::max(strtoul(argv[i], nullptr, 10), 1ul);
+        else
+            frameCount = strtoul(argv[i], nullptr, 10);
+    }
+
+    Game game(headless);
+    const size_t allocationCount = game.runRenderBenchmark(petCount, frameCount);
+
+    if (noAllocation && allocationCount != 0)
+    {
+        logf(ELogLevel::Error, "%zu heap allocations during the steady state frames\n", allocationCount);
+        return EXIT_FAILURE;
+    }
+    return 0;
+}